@@ -1,17 +1,59 @@
 #ifndef _ALGORITH_HPP_INCLUDED_
 #define _ALGORITH_HPP_INCLUDED_
 #include "common.hpp"
+#include "iterator_traits.hpp"
+#include "type_traits.hpp"
+#include "simd.hpp"
 
 namespace ft {
-    // equal
+    namespace detail {
+        template <class InputIterator1, class InputIterator2>
+        bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, false_type) {
+            while (first1 != last1) {
+                if (!(*first1 == *first2))
+                    return false;
+                first1++, first2++;
+            }
+            return true;
+        }
+
+        template <class ContiguousIterator1, class ContiguousIterator2>
+        bool equal(ContiguousIterator1 first1, ContiguousIterator1 last1, ContiguousIterator2 first2, true_type) {
+            size_t n = last1 - first1;
+            return n == 0 || equal_elements(&*first1, &*first2, n);
+        }
+
+        template <class InputIterator1, class InputIterator2>
+        bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                     InputIterator2 first2, InputIterator2 last2, false_type)
+        {
+            while (first1 != last1) {
+                if (first2 == last2 || *first2 < *first1)
+                    return false;
+                if (*first1 < *first2)
+                    return true;
+                first1++, first2++;
+            }
+            return first2 != last2;
+        }
+
+        template <class ContiguousIterator1, class ContiguousIterator2>
+        bool lexicographical_compare(ContiguousIterator1 first1, ContiguousIterator1 last1,
+                                     ContiguousIterator2 first2, ContiguousIterator2 last2, true_type)
+        {
+            size_t n1 = last1 - first1;
+            size_t n2 = last2 - first2;
+            if (n1 == 0 || n2 == 0)
+                return n1 < n2;
+            return less_elements(&*first1, n1, &*first2, n2);
+        }
+    } // namespace detail
+
+    // equal, contiguous ranges of arithmetic types are compared in bulk
     template <class InputIterator1, class InputIterator2>
     bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
-        while (first1 != last1) {
-            if (!(*first1 == *first2))
-                return false;
-            first1++, first2++;
-        }
-        return true;
+        typedef integral_constant<bool, detail::simd_comparable<InputIterator1, InputIterator2>::value> bulk;
+        return detail::equal(first1, last1, first2, bulk());
     }
     
     template <class InputIterator1, class InputIterator2, class BinaryPredicate>
@@ -24,19 +66,13 @@ namespace ft {
         return true;
     }
 
-    // lexicographical compare
+    // lexicographical compare, in bulk like equal
     template<class InputIterator1, class InputIterator2>
     bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1, 
                                  InputIterator2 first2, InputIterator2 last2)
     {
-        while (first1 != last1) {
-            if (first2 == last2 || *first2 < *first1)
-                return false;
-            if (*first1 < *first2)
-                return true;
-            first1++, first2++;
-        }
-        return first2 != last2;
+        typedef integral_constant<bool, detail::simd_comparable<InputIterator1, InputIterator2>::value> bulk;
+        return detail::lexicographical_compare(first1, last1, first2, last2, bulk());
     }
     
     template<class InputIterator1, class InputIterator2, class Compare>
@@ -53,6 +89,280 @@ namespace ft {
         }
         return first2 != last2;
     }
+
+    // for_each
+    template <class InputIterator, class Function>
+    Function for_each(InputIterator first, InputIterator last, Function f) {
+        for (; first != last; ++first)
+            f(*first);
+        return f;
+    }
+
+    // transform
+    template <class InputIterator, class OutputIterator, class UnaryOperation>
+    OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op) {
+        for (; first != last; ++first, ++result)
+            *result = op(*first);
+        return result;
+    }
+
+    // reduce, the sequential version folds left to right
+    template <class InputIterator, class T, class BinaryOperation>
+    T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+        for (; first != last; ++first)
+            init = op(init, *first);
+        return init;
+    }
+
+    template <class InputIterator, class T>
+    T reduce(InputIterator first, InputIterator last, T init) {
+        for (; first != last; ++first)
+            init = init + *first;
+        return init;
+    }
+
+    // find
+    template <class InputIterator, class T>
+    InputIterator find(InputIterator first, InputIterator last, const T& val) {
+        for (; first != last; ++first) {
+            if (*first == val)
+                return first;
+        }
+        return last;
+    }
+
+    // count
+    template <class InputIterator, class T>
+    typename iterator_traits<InputIterator>::difference_type
+    count(InputIterator first, InputIterator last, const T& val) {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first) {
+            if (*first == val)
+                n++;
+        }
+        return n;
+    }
+
+    // count_if
+    template <class InputIterator, class UnaryPredicate>
+    typename iterator_traits<InputIterator>::difference_type
+    count_if(InputIterator first, InputIterator last, UnaryPredicate pred) {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first) {
+            if (pred(*first))
+                n++;
+        }
+        return n;
+    }
+
+    // copy
+    template <class InputIterator, class OutputIterator>
+    OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result) {
+        for (; first != last; ++first, ++result)
+            *result = *first;
+        return result;
+    }
+
+    // remove_if: moves the elements failing pred to the front, in order,
+    // and returns the end of them. Each one is assigned at most once
+    template <class ForwardIterator, class UnaryPredicate>
+    ForwardIterator remove_if(ForwardIterator first, ForwardIterator last, UnaryPredicate pred) {
+        for (; first != last && !pred(*first); ++first) ;
+        if (first == last)
+            return first;
+        ForwardIterator result = first;
+        for (++first; first != last; ++first) {
+            if (!pred(*first)) {
+                *result = *first;
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // fill
+    template <class ForwardIterator, class T>
+    void fill(ForwardIterator first, ForwardIterator last, const T& val) {
+        for (; first != last; ++first)
+            *first = val;
+    }
+
+    // sort: introsort, quicksort on a median of three falling back to
+    // heapsort when the recursion gets too deep and to insertion sort on
+    // short ranges. Not stable.
+    namespace detail {
+        template <class RandomAccessIterator>
+        void iter_swap(RandomAccessIterator a, RandomAccessIterator b) {
+            typename iterator_traits<RandomAccessIterator>::value_type tmp = *a;
+            *a = *b;
+            *b = tmp;
+        }
+
+        template <class RandomAccessIterator, class Compare>
+        void insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+            if (first == last)
+                return ;
+            for (RandomAccessIterator i = first + 1; i != last; ++i) {
+                typename iterator_traits<RandomAccessIterator>::value_type tmp = *i;
+                RandomAccessIterator j = i;
+                for (; j != first && comp(tmp, *(j - 1)); --j)
+                    *j = *(j - 1);
+                *j = tmp;
+            }
+        }
+
+        template <class RandomAccessIterator, class Distance, class Compare>
+        void sift_down(RandomAccessIterator first, Distance root, Distance n, Compare comp) {
+            while (2 * root + 1 < n) {
+                Distance child = 2 * root + 1;
+                if (child + 1 < n && comp(first[child], first[child + 1]))
+                    child++;
+                if (!comp(first[root], first[child]))
+                    return ;
+                iter_swap(first + root, first + child);
+                root = child;
+            }
+        }
+
+        template <class RandomAccessIterator, class Compare>
+        void heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+            typename iterator_traits<RandomAccessIterator>::difference_type n = last - first;
+            for (typename iterator_traits<RandomAccessIterator>::difference_type i = n / 2; i > 0; i--)
+                sift_down(first, i - 1, n, comp);
+            for (; n > 1; n--) {
+                iter_swap(first, first + (n - 1));
+                sift_down(first, typename iterator_traits<RandomAccessIterator>::difference_type(0), n - 1, comp);
+            }
+        }
+
+        template <class T, class Compare>
+        const T &median(const T &a, const T &b, const T &c, Compare comp) {
+            if (comp(a, b))
+                return comp(b, c) ? b : (comp(a, c) ? c : a);
+            return comp(a, c) ? a : (comp(b, c) ? c : b);
+        }
+
+        template <class RandomAccessIterator, class Compare>
+        void intro_sort(RandomAccessIterator first, RandomAccessIterator last, size_t depth, Compare comp) {
+            typedef typename iterator_traits<RandomAccessIterator>::difference_type difference_type;
+            typedef typename iterator_traits<RandomAccessIterator>::value_type      value_type;
+
+            while (last - first > 16) {
+                if (depth-- == 0) {
+                    heap_sort(first, last, comp);
+                    return ;
+                }
+                difference_type i = 0;
+                difference_type j = last - first - 1;
+                value_type      pivot = median(first[0], first[j / 2], first[j], comp);
+                while (true) {
+                    while (comp(first[i], pivot))
+                        i++;
+                    while (comp(pivot, first[j]))
+                        j--;
+                    if (i >= j)
+                        break ;
+                    iter_swap(first + i, first + j);
+                    i++;
+                    j--;
+                }
+                intro_sort(first + j + 1, last, depth, comp);
+                last = first + j + 1;
+            }
+            insertion_sort(first, last, comp);
+        }
+
+        template <class T>
+        struct less_than {
+            bool operator()(const T &a, const T &b) const {
+                return a < b;
+            }
+        };
+    } // namespace detail
+
+    // stable sorts of arrays, for when equal elements must keep their
+    // order. Both go through a buffer as long as the array
+    namespace detail {
+        // merge sort, insertion sort below 16 elements; two halves already
+        // in order are not merged, so sorted input costs one compare per
+        // run
+        template <class T, class Compare>
+        void merge_sort(T *first, T *last, T *buffer, Compare comp) {
+            if (last - first <= 16) {
+                insertion_sort(first, last, comp);
+                return ;
+            }
+            T *mid = first + (last - first) / 2;
+            merge_sort(first, mid, buffer, comp);
+            merge_sort(mid, last, buffer, comp);
+            if (!comp(*mid, *(mid - 1)))
+                return ;
+            T *left = first;
+            T *right = mid;
+            T *out = buffer;
+            while (left != mid && right != last)
+                *out++ = comp(*right, *left) ? *right++ : *left++;
+            while (left != mid)
+                *out++ = *left++;
+            // what is left of the right half is in place already
+            copy(buffer, out, first);
+        }
+
+        template <class T>
+        struct radix_item {
+            uint64_t key;
+            T        value;
+        };
+
+        // LSD radix sort on the keys, a byte per pass. The counts of all
+        // eight bytes come from one read of the keys, and a pass whose
+        // byte is the same everywhere is skipped
+        template <class T>
+        void radix_sort(radix_item<T> *first, radix_item<T> *last, radix_item<T> *buffer) {
+            size_t n = last - first;
+            if (n < 2)
+                return ;
+            size_t counts[8][256] = {{0}};
+            for (radix_item<T> *it = first; it != last; ++it) {
+                for (size_t pass = 0; pass < 8; pass++)
+                    counts[pass][(it->key >> (8 * pass)) & 0xff]++;
+            }
+            radix_item<T> *from = first;
+            radix_item<T> *to = buffer;
+            for (size_t pass = 0; pass < 8; pass++) {
+                size_t *count = counts[pass];
+                size_t shift = 8 * pass;
+                if (count[(from->key >> shift) & 0xff] == n)
+                    continue ;
+                size_t offset = 0;
+                for (size_t byte = 0; byte < 256; byte++) {
+                    size_t c = count[byte];
+                    count[byte] = offset;
+                    offset += c;
+                }
+                for (size_t i = 0; i < n; i++)
+                    to[count[(from[i].key >> shift) & 0xff]++] = from[i];
+                radix_item<T> *tmp = from;
+                from = to;
+                to = tmp;
+            }
+            if (from != first)
+                copy(from, from + n, first);
+        }
+    } // namespace detail
+
+    template <class RandomAccessIterator, class Compare>
+    void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        size_t depth = 0;
+        for (size_t n = last - first; n > 1; n >>= 1)
+            depth += 2;
+        detail::intro_sort(first, last, depth, comp);
+    }
+
+    template <class RandomAccessIterator>
+    void sort(RandomAccessIterator first, RandomAccessIterator last) {
+        ft::sort(first, last, detail::less_than<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
 } // namespace ft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#ifndef _SIMD_HPP_INCLUDED_
+#define _SIMD_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstring>
+#include "type_traits.hpp"
+#include "VectorIterator.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+#endif
+
+// Kernels behind equal and lexicographical_compare on contiguous ranges of
+// arithmetic types. Integer equality is byte equality and goes to memcmp,
+// which the C library already vectorizes for the running cpu. Floats
+// compare by value (NaN differs from itself, -0 equals 0) with SSE2, or
+// AVX when the cpu has it. Finding the first differing element of two
+// integer ranges is a byte search with SSE2 or AVX2. The word kernels of
+// vector<bool> count bits with POPCNT and skip uniform words with AVX2.
+
+namespace ft {
+    namespace detail {
+        // iterators whose elements sit next to each other in memory
+        template <class Iterator>
+        struct contiguous_iterator {
+            static const bool value = false;
+            typedef void      element;
+        };
+
+        template <class T>
+        struct contiguous_iterator<T*> {
+            static const bool value = true;
+            typedef T         element;
+        };
+
+        template <class T>
+        struct contiguous_iterator<VectorIterator<T> > {
+            static const bool value = true;
+            typedef T         element;
+        };
+
+        // both ranges contiguous, of the same arithmetic type
+        template <class Iterator1, class Iterator2>
+        struct simd_comparable {
+            typedef typename remove_const<typename contiguous_iterator<Iterator1>::element>::type element;
+            typedef typename remove_const<typename contiguous_iterator<Iterator2>::element>::type other;
+
+            static const bool value = contiguous_iterator<Iterator1>::value
+                                   && contiguous_iterator<Iterator2>::value
+                                   && is_same<element, other>::value
+                                   && (is_integral<element>::value || is_floating_point<element>::value);
+        };
+
+        template <class T>
+        size_t mismatch_scalar(const T *a, const T *b, size_t i, size_t n) {
+            while (i < n && a[i] == b[i])
+                i++;
+            return i;
+        }
+
+        inline size_t popcount_words_scalar(const uint64_t *w, size_t n) {
+            size_t count = 0;
+            for (size_t i = 0; i < n; i++)
+                count += __builtin_popcountll(w[i]);
+            return count;
+        }
+
+        inline size_t find_word_scalar(const uint64_t *w, size_t i, size_t n, uint64_t skip) {
+            while (i < n && w[i] == skip)
+                i++;
+            return i;
+        }
+
+#if defined(__x86_64__) || defined(__i386__)
+        inline bool cpu_has_avx() {
+            static const bool avx = __builtin_cpu_supports("avx");
+            return avx;
+        }
+
+        inline bool cpu_has_avx2() {
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+            return avx2;
+        }
+
+        inline bool cpu_has_popcnt() {
+            static const bool popcnt = __builtin_cpu_supports("popcnt");
+            return popcnt;
+        }
+
+        __attribute__((target("sse2")))
+        inline size_t mismatch_bytes_sse2(const unsigned char *a, const unsigned char *b, size_t i, size_t n) {
+            for (; i + 16 <= n; i += 16) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+                if (equal != 0xffff)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_scalar(a, b, i, n);
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t mismatch_bytes_avx2(const unsigned char *a, const unsigned char *b, size_t n) {
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                __m256i  x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i  y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                unsigned equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+                if (equal != 0xffffffffu)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_bytes_sse2(a, b, i, n);
+        }
+
+        inline size_t mismatch_bytes(const unsigned char *a, const unsigned char *b, size_t n) {
+            return cpu_has_avx2() ? mismatch_bytes_avx2(a, b, n) : mismatch_bytes_sse2(a, b, 0, n);
+        }
+
+        __attribute__((target("sse2")))
+        inline size_t mismatch_sse2(const float *a, const float *b, size_t i, size_t n) {
+            for (; i + 4 <= n; i += 4) {
+                unsigned equal = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                if (equal != 0xf)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_scalar(a, b, i, n);
+        }
+
+        __attribute__((target("avx")))
+        inline size_t mismatch_avx(const float *a, const float *b, size_t n) {
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256   equalMask = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+                unsigned equal = _mm256_movemask_ps(equalMask);
+                if (equal != 0xff)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_sse2(a, b, i, n);
+        }
+
+        __attribute__((target("sse2")))
+        inline size_t mismatch_sse2(const double *a, const double *b, size_t i, size_t n) {
+            for (; i + 2 <= n; i += 2) {
+                unsigned equal = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+                if (equal != 0x3)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_scalar(a, b, i, n);
+        }
+
+        __attribute__((target("avx")))
+        inline size_t mismatch_avx(const double *a, const double *b, size_t n) {
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256d  equalMask = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+                unsigned equal = _mm256_movemask_pd(equalMask);
+                if (equal != 0xf)
+                    return i + __builtin_ctz(~equal);
+            }
+            return mismatch_sse2(a, b, i, n);
+        }
+
+        inline size_t mismatch_elements(const float *a, const float *b, size_t n) {
+            return cpu_has_avx() ? mismatch_avx(a, b, n) : mismatch_sse2(a, b, 0, n);
+        }
+
+        inline size_t mismatch_elements(const double *a, const double *b, size_t n) {
+            return cpu_has_avx() ? mismatch_avx(a, b, n) : mismatch_sse2(a, b, 0, n);
+        }
+
+        __attribute__((target("popcnt")))
+        inline size_t popcount_words_popcnt(const uint64_t *w, size_t n) {
+            size_t count = 0;
+            for (size_t i = 0; i < n; i++)
+                count += __builtin_popcountll(w[i]);
+            return count;
+        }
+
+        __attribute__((target("avx2")))
+        inline size_t find_word_avx2(const uint64_t *w, size_t n, uint64_t skip) {
+            __m256i pattern = _mm256_set1_epi64x(static_cast<long long>(skip));
+            size_t  i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m256i  x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+                unsigned equal = _mm256_movemask_epi8(_mm256_cmpeq_epi64(x, pattern));
+                if (equal != 0xffffffffu)
+                    return i + __builtin_ctz(~equal) / 8;
+            }
+            return find_word_scalar(w, i, n, skip);
+        }
+
+        // number of set bits in the n words of w
+        inline size_t popcount_words(const uint64_t *w, size_t n) {
+            return cpu_has_popcnt() ? popcount_words_popcnt(w, n) : popcount_words_scalar(w, n);
+        }
+
+        // index of the first of the n words of w other than skip, n if none
+        inline size_t find_word(const uint64_t *w, size_t n, uint64_t skip) {
+            return cpu_has_avx2() ? find_word_avx2(w, n, skip) : find_word_scalar(w, 0, n, skip);
+        }
+#else
+        inline size_t mismatch_bytes(const unsigned char *a, const unsigned char *b, size_t n) {
+            return mismatch_scalar(a, b, 0, n);
+        }
+
+        inline size_t mismatch_elements(const float *a, const float *b, size_t n) {
+            return mismatch_scalar(a, b, 0, n);
+        }
+
+        inline size_t mismatch_elements(const double *a, const double *b, size_t n) {
+            return mismatch_scalar(a, b, 0, n);
+        }
+
+        inline size_t popcount_words(const uint64_t *w, size_t n) {
+            return popcount_words_scalar(w, n);
+        }
+
+        inline size_t find_word(const uint64_t *w, size_t n, uint64_t skip) {
+            return find_word_scalar(w, 0, n, skip);
+        }
+#endif
+
+        inline size_t mismatch_elements(const long double *a, const long double *b, size_t n) {
+            return mismatch_scalar(a, b, 0, n);
+        }
+
+        // index of the first element where a and b differ, n if none.
+        // Integers: the first differing byte belongs to that element
+        template <class T>
+        size_t mismatch_elements(const T *a, const T *b, size_t n) {
+            return mismatch_bytes(reinterpret_cast<const unsigned char*>(a),
+                                  reinterpret_cast<const unsigned char*>(b), n * sizeof(T)) / sizeof(T);
+        }
+
+        template <class T>
+        bool equal_elements(const T *a, const T *b, size_t n) {
+            return std::memcmp(a, b, n * sizeof(T)) == 0;
+        }
+
+        inline bool equal_elements(const float *a, const float *b, size_t n) {
+            return mismatch_elements(a, b, n) == n;
+        }
+
+        inline bool equal_elements(const double *a, const double *b, size_t n) {
+            return mismatch_elements(a, b, n) == n;
+        }
+
+        inline bool equal_elements(const long double *a, const long double *b, size_t n) {
+            return mismatch_elements(a, b, n) == n;
+        }
+
+        // memcmp orders unsigned bytes, other types jump from one differing
+        // element to the next (only NaN can compare neither way)
+        template <class T>
+        bool less_elements(const T *a, size_t na, const T *b, size_t nb) {
+            size_t n = na < nb ? na : nb;
+            if (is_integral<T>::value && sizeof(T) == 1 && T(-1) > T(0)) {
+                int order = n ? std::memcmp(a, b, n) : 0;
+                return order ? order < 0 : na < nb;
+            }
+            for (size_t i = 0; (i += mismatch_elements(a + i, b + i, n - i)) < n; i++) {
+                if (a[i] < b[i])
+                    return true;
+                if (b[i] < a[i])
+                    return false;
+            }
+            return na < nb;
+        }
+    } // namespace detail
+} // namespace ft
+
+#endif
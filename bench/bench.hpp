@@ -0,0 +1,42 @@
+#ifndef _BENCH_HPP_INCLUDED_
+#define _BENCH_HPP_INCLUDED_
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+#include <stdint.h>
+
+// seconds on the monotonic clock
+inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift64*, cheap enough not to show up in the measurements
+struct bench_rng {
+    uint64_t state;
+
+    explicit bench_rng(uint64_t seed) : state(seed * 2654435761ULL + 1) {}
+
+    uint64_t next(void) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+};
+
+inline size_t bench_cpus(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? n : 1;
+}
+
+inline void bench_report(const std::string &name, double seconds, double ops) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(3) << seconds << " s"
+              << std::setw(12) << std::setprecision(2) << ops / seconds / 1e6 << " Mops/s" << std::endl;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <sstream>
+#include "bench.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+
+// unsorted batches of random 64 bit keys going into a map that already
+// holds a million, through insert(first, last), one descent per element,
+// and through bulk_insert, which radix sorts the batch and links it in
+// order, each key searched for from the one before
+
+static const size_t elements = 1 << 20;
+
+typedef ft::map<uint64_t, uint64_t>  map_type;
+typedef ft::pair<uint64_t, uint64_t> value_type;
+
+static void fill(map_type &m) {
+    bench_rng rng(1);
+    for (size_t i = 0; i < elements; i++)
+        m[rng.next()] = i;
+}
+
+static void run(size_t batchSize) {
+    ft::vector<value_type> batch(batchSize);
+    bench_rng              rng(batchSize);
+    for (size_t i = 0; i < batchSize; i++)
+        batch[i] = value_type(rng.next(), i);
+    map_type loop;
+    map_type bulk;
+    fill(loop);
+    fill(bulk);
+
+    std::ostringstream name;
+    name << "insert, batch of " << batchSize;
+    double start = bench_now();
+    loop.insert(batch.begin(), batch.end());
+    bench_report(name.str(), bench_now() - start, batchSize);
+
+    name.str("");
+    name << "bulk_insert, batch of " << batchSize;
+    start = bench_now();
+    bulk.bulk_insert(batch.begin(), batch.end());
+    bench_report(name.str(), bench_now() - start, batchSize);
+    if (loop.size() != bulk.size())
+        std::cout << "bulk_insert size mismatch" << std::endl;
+}
+
+int main(void) {
+    for (size_t batchSize = 1000; batchSize <= 1000000; batchSize *= 10)
+        run(batchSize);
+    return 0;
+}
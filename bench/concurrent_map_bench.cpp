@@ -0,0 +1,101 @@
+#include <pthread.h>
+#include <sstream>
+#include "bench.hpp"
+#include "map.hpp"
+#include "concurrent_map.hpp"
+
+// mixed workload: 90% find, 5% insert, 5% erase over a preloaded key space,
+// ft::concurrent_map against a single ft::map behind one mutex
+
+static const uint64_t key_space = 1 << 20;
+static const size_t   ops_per_thread = 1 << 18;
+
+struct locked_map {
+    pthread_mutex_t   lock;
+    ft::map<int, int> map;
+
+    locked_map() {
+        pthread_mutex_init(&lock, NULL);
+    }
+
+    ~locked_map() {
+        pthread_mutex_destroy(&lock);
+    }
+};
+
+struct job {
+    ft::concurrent_map<int, int> *sharded;
+    locked_map                   *global;
+    uint64_t                     seed;
+};
+
+static void *run_sharded(void *arg) {
+    job       *j = static_cast<job*>(arg);
+    bench_rng rng(j->seed);
+    int       out;
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        uint64_t r = rng.next();
+        int      key = r % key_space;
+        switch ((r >> 32) % 20) {
+            case 0: j->sharded->insert_or_assign(key, key); break;
+            case 1: j->sharded->erase(key); break;
+            default: j->sharded->find(key, out);
+        }
+    }
+    return NULL;
+}
+
+static void *run_global(void *arg) {
+    job       *j = static_cast<job*>(arg);
+    bench_rng rng(j->seed);
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        uint64_t r = rng.next();
+        int      key = r % key_space;
+        pthread_mutex_lock(&j->global->lock);
+        switch ((r >> 32) % 20) {
+            case 0: j->global->map[key] = key; break;
+            case 1: j->global->map.erase(key); break;
+            default: j->global->map.find(key);
+        }
+        pthread_mutex_unlock(&j->global->lock);
+    }
+    return NULL;
+}
+
+static double run(void *(*fn)(void *), job &proto, size_t threads) {
+    pthread_t *ids = new pthread_t[threads];
+    job       *jobs = new job[threads];
+    double    start = bench_now();
+    for (size_t i = 0; i < threads; i++) {
+        jobs[i] = proto;
+        jobs[i].seed = i + 1;
+        pthread_create(&ids[i], NULL, fn, &jobs[i]);
+    }
+    for (size_t i = 0; i < threads; i++)
+        pthread_join(ids[i], NULL);
+    double elapsed = bench_now() - start;
+    delete[] ids;
+    delete[] jobs;
+    return elapsed;
+}
+
+int main(void) {
+    ft::concurrent_map<int, int> sharded(64);
+    locked_map                   global;
+    for (uint64_t k = 0; k < key_space; k += 2) {
+        sharded.insert(ft::make_pair<const int, int>(k, k));
+        global.map[k] = k;
+    }
+
+    job proto;
+    proto.sharded = &sharded;
+    proto.global = &global;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        std::ostringstream name;
+        name << threads << " threads";
+        bench_report(name.str() + ", global mutex", run(run_global, proto, threads), threads * ops_per_thread);
+        bench_report(name.str() + ", 64 shards", run(run_sharded, proto, threads), threads * ops_per_thread);
+    }
+    std::cout << "(" << bench_cpus() << " cpus online)" << std::endl;
+    return 0;
+}
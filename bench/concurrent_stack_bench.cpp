@@ -0,0 +1,96 @@
+#include <pthread.h>
+#include <sstream>
+#include "bench.hpp"
+#include "stack.hpp"
+#include "concurrent_stack.hpp"
+#include "mpmc_queue.hpp"
+
+// every thread pushes an item and pops one back, ft::concurrent_stack and
+// ft::mpmc_queue against an ft::stack behind one mutex
+
+static const size_t ops_per_thread = 1 << 19;
+
+struct locked_stack {
+    pthread_mutex_t  lock;
+    ft::stack<long>  stack;
+
+    locked_stack() {
+        pthread_mutex_init(&lock, NULL);
+    }
+
+    ~locked_stack() {
+        pthread_mutex_destroy(&lock);
+    }
+};
+
+struct job {
+    locked_stack              *locked;
+    ft::concurrent_stack<long> *lockfree;
+    ft::mpmc_queue<long>       *queue;
+};
+
+static void *run_locked(void *arg) {
+    job *j = static_cast<job*>(arg);
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        pthread_mutex_lock(&j->locked->lock);
+        j->locked->stack.push(i);
+        pthread_mutex_unlock(&j->locked->lock);
+        pthread_mutex_lock(&j->locked->lock);
+        j->locked->stack.pop();
+        pthread_mutex_unlock(&j->locked->lock);
+    }
+    return NULL;
+}
+
+static void *run_lockfree(void *arg) {
+    job  *j = static_cast<job*>(arg);
+    long out;
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        j->lockfree->push(i);
+        j->lockfree->pop(out);
+    }
+    return NULL;
+}
+
+static void *run_queue(void *arg) {
+    job  *j = static_cast<job*>(arg);
+    long out;
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        while (!j->queue->push(i))
+            ;
+        j->queue->pop(out);
+    }
+    return NULL;
+}
+
+static double run(void *(*fn)(void *), job &proto, size_t threads) {
+    pthread_t *ids = new pthread_t[threads];
+    double    start = bench_now();
+    for (size_t i = 0; i < threads; i++)
+        pthread_create(&ids[i], NULL, fn, &proto);
+    for (size_t i = 0; i < threads; i++)
+        pthread_join(ids[i], NULL);
+    double elapsed = bench_now() - start;
+    delete[] ids;
+    return elapsed;
+}
+
+int main(void) {
+    locked_stack               locked;
+    ft::concurrent_stack<long> lockfree;
+    ft::mpmc_queue<long>       queue(1024);
+
+    job proto;
+    proto.locked = &locked;
+    proto.lockfree = &lockfree;
+    proto.queue = &queue;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        std::ostringstream name;
+        name << threads << " threads";
+        bench_report(name.str() + ", mutex + ft::stack", run(run_locked, proto, threads), 2 * threads * ops_per_thread);
+        bench_report(name.str() + ", concurrent_stack", run(run_lockfree, proto, threads), 2 * threads * ops_per_thread);
+        bench_report(name.str() + ", mpmc_queue", run(run_queue, proto, threads), 2 * threads * ops_per_thread);
+    }
+    std::cout << "(" << bench_cpus() << " cpus online)" << std::endl;
+    return 0;
+}
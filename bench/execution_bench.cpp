@@ -0,0 +1,52 @@
+#include "bench.hpp"
+#include "vector.hpp"
+#include "execution.hpp"
+
+// sequential against parallel policies on one large ft::vector<long>
+
+static const size_t elements = 1 << 24;
+
+struct square {
+    long operator()(long x) const {
+        return x * x;
+    }
+};
+
+static void fill_random(ft::vector<long> &v) {
+    bench_rng rng(1);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = rng.next() >> 1;
+}
+
+template <class Policy>
+static void run(const std::string &name, const Policy &policy) {
+    ft::vector<long> v(elements);
+    ft::vector<long> out(elements);
+    fill_random(v);
+
+    double start = bench_now();
+    ft::sort(policy, v.begin(), v.end());
+    bench_report("sort, " + name, bench_now() - start, elements);
+
+    start = bench_now();
+    ft::transform(policy, v.begin(), v.end(), out.begin(), square());
+    bench_report("transform, " + name, bench_now() - start, elements);
+
+    start = bench_now();
+    volatile long sum = ft::reduce(policy, out.begin(), out.end(), 0L);
+    (void)sum;
+    bench_report("reduce, " + name, bench_now() - start, elements);
+
+    start = bench_now();
+    ft::fill(policy, out.begin(), out.end(), 3L);
+    bench_report("fill, " + name, bench_now() - start, elements);
+}
+
+int main(void) {
+    run("seq", ft::execution::seq);
+    run("unseq", ft::execution::unseq);
+    run("par", ft::execution::par);
+    run("par_unseq", ft::execution::par_unseq);
+    std::cout << "(" << bench_cpus() << " cpus online)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <sstream>
+#include "bench.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+
+// find against find_many on an ft::map far larger than the last level
+// cache, looking random keys up in batches of 1 to 256. The map is filled
+// in random order so that neighbours in the tree are not neighbours in
+// memory
+
+static const size_t elements = 1 << 22;
+static const size_t lookups = 1 << 20;
+
+typedef ft::map<unsigned, unsigned> map_type;
+
+int main(void) {
+    map_type  m;
+    bench_rng rng(1);
+    for (size_t i = 0; i < elements; i++) {
+        unsigned key = rng.next() >> 33;
+        m[key] = i;
+    }
+
+    // most keys are present, one in four is not
+    ft::vector<unsigned> keys(lookups);
+    map_type::iterator   it = m.begin();
+    for (size_t i = 0; i < lookups; i++)
+        keys[i] = rng.next() & 3 ? rng.next() >> 33 : ~0u - (rng.next() & 0xffff);
+
+    double            start = bench_now();
+    volatile unsigned sink = 0;
+    size_t            found = 0;
+    for (size_t i = 0; i < lookups; i++) {
+        it = m.find(keys[i]);
+        if (it != m.end()) {
+            sink = it->second;
+            found++;
+        }
+    }
+    bench_report("find", bench_now() - start, lookups);
+
+    ft::vector<map_type::iterator> out(256, m.end());
+    for (size_t batch = 1; batch <= 256; batch *= 2) {
+        size_t foundMany = 0;
+        start = bench_now();
+        for (size_t i = 0; i + batch <= lookups; i += batch) {
+            m.find_many(keys.begin() + i, keys.begin() + i + batch, out.begin());
+            for (size_t j = 0; j < batch; j++) {
+                if (out[j] != m.end()) {
+                    sink = out[j]->second;
+                    foundMany++;
+                }
+            }
+        }
+        std::ostringstream name;
+        name << "find_many, batches of " << batch;
+        bench_report(name.str(), bench_now() - start, lookups);
+        if (foundMany != found)
+            std::cout << "find_many mismatch" << std::endl;
+    }
+
+    start = bench_now();
+    size_t counted = m.count_many(keys.begin(), keys.end());
+    bench_report("count_many, all at once", bench_now() - start, lookups);
+    if (counted != found)
+        std::cout << "count_many mismatch" << std::endl;
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <pthread.h>
+#include <sstream>
+#include "bench.hpp"
+#include "map.hpp"
+#include "rcu_map.hpp"
+
+// read mostly workload: reader threads look keys up while one writer
+// replaces an entry every millisecond, ft::rcu_map against an ft::map
+// behind a pthread rwlock
+
+static const uint64_t key_space = 1 << 16;
+static const size_t   ops_per_thread = 1 << 20;
+
+struct rwlocked_map {
+    pthread_rwlock_t  lock;
+    ft::map<int, int> map;
+
+    rwlocked_map() {
+        pthread_rwlock_init(&lock, NULL);
+    }
+
+    ~rwlocked_map() {
+        pthread_rwlock_destroy(&lock);
+    }
+};
+
+struct job {
+    ft::rcu_map<int, int> *rcu;
+    rwlocked_map          *locked;
+    uint64_t              seed;
+};
+
+static volatile int readers_done;
+
+static void *read_rcu(void *arg) {
+    job                           *j = static_cast<job*>(arg);
+    ft::rcu_map<int, int>::reader reader(*j->rcu);
+    bench_rng                     rng(j->seed);
+    int                           out;
+    for (size_t i = 0; i < ops_per_thread; i++)
+        reader.find(rng.next() % key_space, out);
+    return NULL;
+}
+
+static void *read_locked(void *arg) {
+    job       *j = static_cast<job*>(arg);
+    bench_rng rng(j->seed);
+    for (size_t i = 0; i < ops_per_thread; i++) {
+        pthread_rwlock_rdlock(&j->locked->lock);
+        j->locked->map.find(rng.next() % key_space);
+        pthread_rwlock_unlock(&j->locked->lock);
+    }
+    return NULL;
+}
+
+static void *write_rcu(void *arg) {
+    job       *j = static_cast<job*>(arg);
+    bench_rng rng(j->seed);
+    while (!__atomic_load_n(&readers_done, __ATOMIC_ACQUIRE)) {
+        j->rcu->insert_or_assign(rng.next() % key_space, 0);
+        usleep(1000);
+    }
+    return NULL;
+}
+
+static void *write_locked(void *arg) {
+    job       *j = static_cast<job*>(arg);
+    bench_rng rng(j->seed);
+    while (!__atomic_load_n(&readers_done, __ATOMIC_ACQUIRE)) {
+        pthread_rwlock_wrlock(&j->locked->lock);
+        j->locked->map[rng.next() % key_space] = 0;
+        pthread_rwlock_unlock(&j->locked->lock);
+        usleep(1000);
+    }
+    return NULL;
+}
+
+static double run(void *(*reader)(void *), void *(*writer)(void *), job &proto, size_t threads) {
+    pthread_t *ids = new pthread_t[threads + 1];
+    job       *jobs = new job[threads + 1];
+    readers_done = 0;
+    for (size_t i = 0; i <= threads; i++) {
+        jobs[i] = proto;
+        jobs[i].seed = i + 1;
+    }
+    pthread_create(&ids[threads], NULL, writer, &jobs[threads]);
+    double start = bench_now();
+    for (size_t i = 0; i < threads; i++)
+        pthread_create(&ids[i], NULL, reader, &jobs[i]);
+    for (size_t i = 0; i < threads; i++)
+        pthread_join(ids[i], NULL);
+    double elapsed = bench_now() - start;
+    __atomic_store_n(&readers_done, 1, __ATOMIC_RELEASE);
+    pthread_join(ids[threads], NULL);
+    delete[] ids;
+    delete[] jobs;
+    return elapsed;
+}
+
+int main(void) {
+    ft::rcu_map<int, int> rcu(128);
+    rwlocked_map          locked;
+    for (uint64_t k = 0; k < key_space; k += 2) {
+        rcu.insert(ft::make_pair<const int, int>(k, k));
+        locked.map[k] = k;
+    }
+
+    job proto;
+    proto.rcu = &rcu;
+    proto.locked = &locked;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        std::ostringstream name;
+        name << threads << " readers";
+        bench_report(name.str() + ", rwlock", run(read_locked, write_locked, proto, threads), threads * ops_per_thread);
+        bench_report(name.str() + ", rcu", run(read_rcu, write_rcu, proto, threads), threads * ops_per_thread);
+    }
+    std::cout << "(" << bench_cpus() << " cpus online)" << std::endl;
+    return 0;
+}
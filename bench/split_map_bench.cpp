@@ -0,0 +1,57 @@
+#include "bench.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+#include "split_map.hpp"
+
+// random lookups in a map and a split_map from 64 bit keys to 256 byte
+// records, far larger than the last level cache. The map drags whole
+// records into the cache on the way down, the split_map only keys; both
+// read one word of the record found
+
+static const size_t elements = 1 << 20;
+static const size_t lookups = 1 << 21;
+
+struct record {
+    uint64_t words[32];
+};
+
+template <class Map>
+static void run(const char *name, ft::vector<uint64_t> const &keys) {
+    Map       m;
+    bench_rng rng(1);
+    double    start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        m[rng.next()].words[0] = i;
+    bench_report(std::string(name) + ", insert", bench_now() - start, elements);
+
+    volatile uint64_t sink = 0;
+    size_t            found = 0;
+    start = bench_now();
+    for (size_t i = 0; i < lookups; i++) {
+        typename Map::iterator it = m.find(keys[i]);
+        if (it != m.end()) {
+            sink = it->second.words[0];
+            found++;
+        }
+    }
+    bench_report(std::string(name) + ", find", bench_now() - start, lookups);
+    if (found != lookups / 2)
+        std::cout << name << " lookups mismatch" << std::endl;
+    (void)sink;
+}
+
+int main(void) {
+    // every other key is present, in the order they were inserted
+    ft::vector<uint64_t> present(elements);
+    bench_rng            rng(1);
+    for (size_t i = 0; i < elements; i++)
+        present[i] = rng.next();
+    bench_rng            pick(2);
+    ft::vector<uint64_t> keys(lookups);
+    for (size_t i = 0; i < lookups; i++)
+        keys[i] = i % 2 ? present[pick.next() % elements] : pick.next() | 1;
+
+    run<ft::map<uint64_t, record> >("map", keys);
+    run<ft::split_map<uint64_t, record> >("split_map", keys);
+    return 0;
+}
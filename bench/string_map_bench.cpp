@@ -0,0 +1,77 @@
+#include <sstream>
+#include <cstdio>
+#include "bench.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+
+// ft::map with std::string keys sharing a long prefix, so every comparison
+// is a real memcmp. Reports the time and the comparator calls per operation
+
+static const size_t elements = 1 << 20;
+
+struct counting_less {
+    static size_t calls;
+
+    bool operator()(const std::string &lhs, const std::string &rhs) const {
+        calls++;
+        return lhs < rhs;
+    }
+};
+
+size_t counting_less::calls = 0;
+
+typedef ft::map<std::string, unsigned, counting_less> map_type;
+
+static std::string make_key(uint64_t n) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "/srv/storage/objects/%016llx", (unsigned long long)n);
+    return buffer;
+}
+
+static void report(const std::string &name, double start, size_t ops) {
+    double seconds = bench_now() - start;
+    std::ostringstream line;
+    line << name << " (" << std::fixed << std::setprecision(1)
+         << double(counting_less::calls) / ops << " cmp/op)";
+    bench_report(line.str(), seconds, ops);
+    counting_less::calls = 0;
+}
+
+int main(void) {
+    ft::vector<std::string> keys;
+    ft::vector<std::string> missing;
+    bench_rng               rng(1);
+    for (size_t i = 0; i < elements; i++) {
+        keys.push_back(make_key(rng.next() << 1));
+        missing.push_back(make_key(rng.next() | 1));
+    }
+
+    map_type m;
+    double   start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        m.insert(ft::make_pair(keys[i], i));
+    report("insert", start, elements);
+
+    volatile size_t sink = 0;
+    start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        sink += m.find(keys[i]) != m.end();
+    report("find, present", start, elements);
+
+    start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        sink += m.find(missing[i]) != m.end();
+    report("find, missing", start, elements);
+
+    start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        sink += m.lower_bound(missing[i]) != m.end();
+    report("lower_bound", start, elements);
+
+    start = bench_now();
+    for (size_t i = 0; i < elements; i++)
+        sink += m.upper_bound(keys[i]) != m.end();
+    report("upper_bound", start, elements);
+    (void)sink;
+    return 0;
+}
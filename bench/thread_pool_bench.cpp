@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include "vector.hpp"
+#include "thread_pool.hpp"
+
+// fork/join on ft::thread_pool against the same work done sequentially:
+// a recursive fibonacci forking at every level down to a cutoff, and a
+// loop whose iterations cost anything from nothing to a lot
+
+static const unsigned fib_n = 36;
+static const unsigned fib_cutoff = 16;
+static const size_t   iterations = 1 << 16;
+
+static unsigned long fib(unsigned n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+struct fib_task {
+    ft::thread_pool *pool;
+    unsigned        n;
+    unsigned long   *result;
+
+    fib_task(ft::thread_pool *pPool, unsigned pN, unsigned long *pResult)
+        : pool(pPool), n(pN), result(pResult) {}
+
+    void operator()() {
+        if (n < fib_cutoff) {
+            *result = fib(n);
+            return ;
+        }
+        unsigned long a = 0;
+        unsigned long b = 0;
+        ft::parallel_invoke(*pool, fib_task(pool, n - 1, &a), fib_task(pool, n - 2, &b));
+        *result = a + b;
+    }
+};
+
+// iteration i spins about i % 1024 steps
+struct uneven {
+    ft::vector<unsigned long> *out;
+
+    explicit uneven(ft::vector<unsigned long> *pOut) : out(pOut) {}
+
+    void operator()(size_t i) const {
+        unsigned long x = i;
+        for (size_t k = 0; k < i % 1024; k++)
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        (*out)[i] = x;
+    }
+};
+
+int main(void) {
+    ft::thread_pool pool;
+
+    double                 start = bench_now();
+    volatile unsigned long seq = fib(fib_n);
+    bench_report("fib, sequential", bench_now() - start, 1);
+
+    unsigned long par = 0;
+    start = bench_now();
+    fib_task(&pool, fib_n, &par)();
+    bench_report("fib, parallel_invoke", bench_now() - start, 1);
+    if (par != seq)
+        std::cout << "fib mismatch" << std::endl;
+
+    ft::vector<unsigned long> out(iterations);
+    uneven                    body(&out);
+    start = bench_now();
+    for (size_t i = 0; i < iterations; i++)
+        body(i);
+    bench_report("uneven loop, sequential", bench_now() - start, iterations);
+
+    start = bench_now();
+    ft::parallel_for(pool, 0, iterations, body);
+    bench_report("uneven loop, parallel_for", bench_now() - start, iterations);
+
+    std::cout << "(" << pool.concurrency() << " workers)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,301 @@
+#ifndef _CIRCULAR_BUFFER_HPP_INCLUDED_
+#define _CIRCULAR_BUFFER_HPP_INCLUDED_
+#include "common.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "CircularIterator.hpp"
+
+namespace ft {
+    // ring of a fixed power-of-two number of slots, allocated once by the
+    // constructor. Both ends push and pop in O(1). A full buffer refuses a
+    // push with length_error, or in overwrite mode drops the element at
+    // the other end to make room, keeping the newest ones. Has what stack
+    // and a queue need from their Container
+    template <class T, class Alloc = std::allocator<T> >
+    class circular_buffer {
+        private:
+            T      *_arr;
+            size_t _mask;
+            size_t _head;
+            size_t _size;
+            bool   _overwrite;
+            Alloc  _alloc;
+
+            static size_t _roundUp(size_t n) {
+                size_t capacity = 1;
+                while (capacity < n)
+                    capacity *= 2;
+                return capacity;
+            }
+
+            size_t _slot(size_t pos) const {
+                return (_head + pos) & _mask;
+            }
+
+            void _init(size_t pCapacity) {
+                _arr = pCapacity ? _alloc.allocate(_roundUp(pCapacity)) : NULL;
+                _mask = pCapacity ? _roundUp(pCapacity) - 1 : size_t(-1);
+                _head = 0;
+                _size = 0;
+            }
+
+        public:
+            typedef T                                                   value_type;
+            typedef Alloc                                               allocator_type;
+            typedef typename allocator_type::reference                  reference;
+            typedef typename allocator_type::const_reference            const_reference;
+            typedef typename allocator_type::pointer                    pointer;
+            typedef typename allocator_type::const_pointer              const_pointer;
+            typedef CircularIterator<value_type>                        iterator;
+            typedef const CircularIterator<value_type>                  const_iterator;
+            typedef ft::reverse_iterator<const_iterator>                const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                      reverse_iterator;
+            typedef ptrdiff_t                                           difference_type;
+            typedef size_t                                              size_type;
+
+            // capacity is rounded up to a power of two, 0 stays 0
+            explicit circular_buffer(size_type capacity = 0, bool overwrite = false, \
+                        const allocator_type& alloc = allocator_type())
+                : _overwrite(overwrite), _alloc(alloc)
+            {
+                _init(capacity);
+            }
+
+            circular_buffer(const circular_buffer& obj) : _overwrite(obj._overwrite), _alloc(obj._alloc) {
+                _init(obj.capacity());
+                for (size_t i = 0; i < obj._size; i++)
+                    push_back(obj[i]);
+            }
+
+            ~circular_buffer() {
+                clear();
+                if (_arr)
+                    _alloc.deallocate(_arr, capacity());
+            }
+
+            // takes rhs's capacity as well as its elements
+            circular_buffer &operator=(const circular_buffer &rhs) {
+                if (this == &rhs)
+                    return *this;
+                circular_buffer tmp(rhs);
+                swap(tmp);
+                return *this;
+            }
+
+            // iterators
+            iterator begin() {
+                return iterator(_arr, _mask, _head, 0);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(_arr, _mask, _head, 0);
+            }
+
+            iterator end() {
+                return iterator(_arr, _mask, _head, _size);
+            }
+
+            const_iterator end() const {
+                return const_iterator(_arr, _mask, _head, _size);
+            }
+
+            reverse_iterator rbegin() {
+                return reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            reverse_iterator rend() {
+                return reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            size_type size() const {
+                return _size;
+            }
+
+            size_type capacity() const {
+                return _mask + 1;
+            }
+
+            size_type max_size() const {
+                return capacity();
+            }
+
+            bool empty() const {
+                return _size == 0;
+            }
+
+            bool full() const {
+                return _size == capacity();
+            }
+
+            bool overwrite() const {
+                return _overwrite;
+            }
+
+            void set_overwrite(bool overwrite) {
+                _overwrite = overwrite;
+            }
+
+            // element access
+            reference operator[] (size_type n) {
+                return _arr[_slot(n)];
+            }
+
+            const_reference operator[] (size_type n) const {
+                return _arr[_slot(n)];
+            }
+
+            reference at(size_type n) {
+                if (n >= _size) throw std::out_of_range("circular_buffer");
+                return (*this)[n];
+            }
+
+            const_reference at(size_type n) const {
+                if (n >= _size) throw std::out_of_range("circular_buffer");
+                return (*this)[n];
+            }
+
+            reference front() {
+                return _arr[_head];
+            }
+
+            const_reference front() const {
+                return _arr[_head];
+            }
+
+            reference back() {
+                return _arr[_slot(_size - 1)];
+            }
+
+            const_reference back() const {
+                return _arr[_slot(_size - 1)];
+            }
+
+            // modifiers
+            // a full buffer throws, or in overwrite mode loses its front
+            void push_back(const value_type& val) {
+                if (full()) {
+                    if (!_overwrite)
+                        throw std::length_error("circular_buffer");
+                    if (_arr == NULL)
+                        return ;
+                    value_type tmp(val); // val may be the element about to go
+                    pop_front();
+                    return push_back(tmp);
+                }
+                _alloc.construct(&_arr[_slot(_size)], val);
+                _size++;
+            }
+
+            // and here its back
+            void push_front(const value_type& val) {
+                if (full()) {
+                    if (!_overwrite)
+                        throw std::length_error("circular_buffer");
+                    if (_arr == NULL)
+                        return ;
+                    value_type tmp(val);
+                    pop_back();
+                    return push_front(tmp);
+                }
+                size_t slot = (_head - 1) & _mask;
+                _alloc.construct(&_arr[slot], val);
+                _head = slot;
+                _size++;
+            }
+
+            void pop_back() {
+                if (empty())
+                    return ;
+                _size--;
+                _alloc.destroy(&_arr[_slot(_size)]);
+            }
+
+            void pop_front() {
+                if (empty())
+                    return ;
+                _alloc.destroy(&_arr[_head]);
+                _head = (_head + 1) & _mask;
+                _size--;
+            }
+
+            void swap(circular_buffer& x) {
+                T      *tmp_arr = x._arr;
+                size_t tmp_mask = x._mask;
+                size_t tmp_head = x._head;
+                size_t tmp_size = x._size;
+                bool   tmp_overwrite = x._overwrite;
+                Alloc  tmp_alloc = x._alloc;
+
+                x._arr = _arr;
+                x._mask = _mask;
+                x._head = _head;
+                x._size = _size;
+                x._overwrite = _overwrite;
+                x._alloc = _alloc;
+
+                _arr = tmp_arr;
+                _mask = tmp_mask;
+                _head = tmp_head;
+                _size = tmp_size;
+                _overwrite = tmp_overwrite;
+                _alloc = tmp_alloc;
+            }
+
+            void clear() {
+                while (!empty())
+                    pop_back();
+                _head = 0;
+            }
+
+            allocator_type get_allocator() const {
+                return _alloc;
+            }
+    };
+
+    // relational operators
+    template <class T, class Alloc>
+    bool operator==(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc>
+    bool operator!=(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class T, class Alloc>
+    bool operator<(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, class Alloc>
+    bool operator<=(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <class T, class Alloc>
+    bool operator>(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <class T, class Alloc>
+    bool operator>=(const circular_buffer<T,Alloc>& lhs, const circular_buffer<T,Alloc>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    template <class T, class Alloc>
+    void swap(circular_buffer<T,Alloc>& x, circular_buffer<T,Alloc>& y) {
+        x.swap(y);
+    }
+} // namespace ft
+
+#endif
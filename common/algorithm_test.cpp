@@ -8,6 +8,7 @@
 #elif defined(USING_FT)
 # define NS ft
 #include "algorithm.hpp"
+#include "vector.hpp"
 #endif
 
 #ifdef NS
@@ -61,4 +62,27 @@ int equal_test (void) {
   return 0;
 }
 
-#endif
\ No newline at end of file
+// long contiguous ranges of arithmetic types, compared in bulk
+int bulk_compare_test(void) {
+  NS::vector<char> c1(1000, 'a');
+  NS::vector<char> c2(c1);
+  std::cout << (c1 == c2) << ' ' << (c1 < c2) << '\n';
+  c2[777] = -5;
+  std::cout << (c1 == c2) << ' ' << (c1 < c2) << ' ' << (c2 < c1) << '\n';
+
+  NS::vector<long> l1(999, 1L << 40);
+  NS::vector<long> l2(l1);
+  l2[500] = -1;
+  std::cout << NS::equal(l1.begin(), l1.end(), l2.begin()) << ' ' << (l2 < l1) << '\n';
+  l2.pop_back();
+  std::cout << NS::equal(l1.begin(), l1.begin() + 500, l2.begin()) << ' ' << (l1 < l2) << '\n';
+
+  NS::vector<double> d1(1001, 0.0);
+  NS::vector<double> d2(1001, -0.0);
+  std::cout << (d1 == d2) << ' ' << (d1 < d2) << '\n';
+  d2[1000] = 0.5;
+  std::cout << (d1 == d2) << ' ' << (d1 < d2) << '\n';
+  return 0;
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include <iostream>
+
+#if defined(USING_STD)
+# define NS std
+#include <deque>
+#include <stack>
+typedef std::deque<int> ring_type;
+# define RING(capacity)
+// what overwrite mode does, on a deque
+# define PUSH_BACK(r, val) do { if (r.size() == 8) r.pop_front(); r.push_back(val); } while (0)
+# define PUSH_FRONT(r, val) do { if (r.size() == 8) r.pop_back(); r.push_front(val); } while (0)
+# define NO_OVERWRITE(r)
+#elif defined(USING_FT)
+# define NS ft
+#include "circular_buffer.hpp"
+#include "stack.hpp"
+typedef ft::circular_buffer<int> ring_type;
+# define RING(capacity) (capacity, true)
+# define PUSH_BACK(r, val) r.push_back(val)
+# define PUSH_FRONT(r, val) r.push_front(val)
+# define NO_OVERWRITE(r) r.set_overwrite(false)
+#endif
+
+#ifdef NS
+
+int circular_buffer_test(void) {
+    std::cout << "circular buffer test: " << std::endl;
+    ring_type window RING(8);
+    for (int i = 0; i < 21; i++)
+        PUSH_BACK(window, i);
+    PUSH_FRONT(window, -1);
+    window.pop_back();
+    PUSH_BACK(window, 100);
+
+    std::cout << "size: " << window.size() << " front: " << window.front() << " back: " << window.back() << std::endl;
+    for (ring_type::iterator it = window.begin(); it != window.end(); ++it)
+        std::cout << ' ' << *it;
+    std::cout << std::endl;
+    for (ring_type::reverse_iterator it = window.rbegin(); it != window.rend(); ++it)
+        std::cout << ' ' << *it;
+    std::cout << std::endl;
+    std::cout << window[3] << ' ' << window.end() - window.begin() << ' ' << *(window.begin() + 5) << std::endl;
+
+    ring_type copy(window);
+    copy.pop_front();
+    std::cout << (copy == window) << (copy < window) << (window < copy) << std::endl;
+
+    NO_OVERWRITE(window);
+    NS::stack<int, ring_type> lifo(window);
+    lifo.pop();
+    lifo.push(42);
+    while (!lifo.empty()) {
+        std::cout << ' ' << lifo.top();
+        lifo.pop();
+    }
+    std::cout << std::endl;
+    return 0;
+}
+
+#endif
@@ -3,5 +3,6 @@
 # include <memory>
 # include <cstddef>
 # include <stdexcept>
+# include <stdint.h>
 
 #endif
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <pthread.h>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+# define CONCURRENT_MAP(K, T) locked_map<K, T>
+#include <map>
+
+// the standard library has no concurrent map: one std::map behind a single
+// mutex answers the same way, only slower
+template <class Key, class T>
+class locked_map {
+    private:
+        std::map<Key, T>        _map;
+        mutable pthread_mutex_t _lock;
+
+        struct _Lock {
+            pthread_mutex_t *lock;
+            explicit _Lock(pthread_mutex_t *pLock) : lock(pLock) { pthread_mutex_lock(lock); }
+            ~_Lock() { pthread_mutex_unlock(lock); }
+        };
+
+    public:
+        locked_map() { pthread_mutex_init(&_lock, NULL); }
+        ~locked_map() { pthread_mutex_destroy(&_lock); }
+
+        size_t size() const { _Lock lock(&_lock); return _map.size(); }
+        bool empty() const { return size() == 0; }
+        bool insert(const std::pair<const Key, T> &val) { _Lock lock(&_lock); return _map.insert(val).second; }
+
+        bool insert_or_assign(const Key &k, const T &obj) {
+            _Lock lock(&_lock);
+            bool added = !_map.count(k);
+            _map[k] = obj;
+            return added;
+        }
+
+        template <class Function>
+        void update(const Key &k, Function f) { _Lock lock(&_lock); f(_map[k]); }
+
+        size_t erase(const Key &k) { _Lock lock(&_lock); return _map.erase(k); }
+        void clear() { _Lock lock(&_lock); _map.clear(); }
+
+        bool find(const Key &k, T &out) const {
+            _Lock lock(&_lock);
+            typename std::map<Key, T>::const_iterator it = _map.find(k);
+            if (it == _map.end())
+                return false;
+            out = it->second;
+            return true;
+        }
+
+        size_t count(const Key &k) const { _Lock lock(&_lock); return _map.count(k); }
+
+        template <class Function>
+        Function for_each(Function f) const {
+            _Lock lock(&_lock);
+            for (typename std::map<Key, T>::const_iterator it = _map.begin(); it != _map.end(); ++it)
+                f(*it);
+            return f;
+        }
+};
+#elif defined(USING_FT)
+# define NS ft
+# define CONCURRENT_MAP(K, T) ft::concurrent_map<K, T>
+#include "concurrent_map.hpp"
+#endif
+
+#ifdef NS
+
+typedef CONCURRENT_MAP(int, long) concurrent_map_type;
+
+static const int concurrent_map_threads = 4;
+static const int concurrent_map_keys = 20000;
+static const int concurrent_map_bumps = 1000;
+
+struct concurrent_map_printer {
+    void operator()(const NS::pair<const int, long> &val) const {
+        std::cout << ' ' << val.first << ':' << val.second;
+    }
+};
+
+struct concurrent_map_add_one {
+    void operator()(long &value) const { value++; }
+};
+
+// walks the merged shards, they must come back in key order with the
+// values the writers left
+struct concurrent_map_checker {
+    long count;
+    long wrong;
+    int  last;
+    concurrent_map_checker() : count(0), wrong(0), last(-2) {}
+    void operator()(const NS::pair<const int, long> &val) {
+        if (val.first <= last)
+            wrong++;
+        else if (val.first >= 0 && (val.first % 10 == 0 || val.second != val.first * 3L))
+            wrong++;
+        last = val.first;
+        count++;
+    }
+};
+
+struct concurrent_map_job {
+    concurrent_map_type *map;
+    int                 id;
+};
+
+// each thread owns the keys equal to its id modulo the thread count, fills
+// them in, erases its multiples of ten and bumps the one shared counter
+static void *concurrent_map_writer(void *arg) {
+    concurrent_map_job *job = static_cast<concurrent_map_job*>(arg);
+    for (int k = job->id; k < concurrent_map_keys; k += concurrent_map_threads) {
+        job->map->insert(NS::make_pair(k, k * 3L));
+        if (k % 7 == 0)
+            job->map->update(-1, concurrent_map_add_one());
+    }
+    for (int k = job->id; k < concurrent_map_keys; k += concurrent_map_threads)
+        if (k % 10 == 0)
+            job->map->erase(k);
+    for (int i = 0; i < concurrent_map_bumps; i++)
+        job->map->update(-1, concurrent_map_add_one());
+    return NULL;
+}
+
+int concurrent_map_test(void) {
+    std::cout << "concurrent map test: \n";
+    {
+        concurrent_map_type m;
+        for (int i = 0; i < 20; i++)
+            m.insert(NS::make_pair((i * 13) % 20, i * 2L));
+        long out = -1;
+        std::cout << m.size() << ' ' << m.empty() << ' ' << m.insert(NS::make_pair(3, 0L)) << ' '
+                  << m.insert_or_assign(3, 33) << ' ' << m.insert_or_assign(30, 300) << ' '
+                  << m.find(3, out) << ' ' << out << ' ' << m.find(99, out) << ' ' << out << ' '
+                  << m.count(7) << ' ' << m.count(-7) << std::endl;
+        std::cout << m.erase(5) << ' ' << m.erase(5) << ' ' << m.erase(100) << ' ' << m.size() << std::endl;
+        m.update(50, concurrent_map_add_one());
+        m.update(3, concurrent_map_add_one());
+        std::cout << "size: " << m.size() << " |";
+        m.for_each(concurrent_map_printer());
+        std::cout << std::endl;
+        m.clear();
+        std::cout << m.size() << ' ' << m.empty() << ' ' << m.count(3) << std::endl;
+    }
+    {
+        concurrent_map_type m;
+        pthread_t           ids[concurrent_map_threads];
+        concurrent_map_job  jobs[concurrent_map_threads];
+        for (int i = 0; i < concurrent_map_threads; i++) {
+            jobs[i].map = &m;
+            jobs[i].id = i;
+            pthread_create(&ids[i], NULL, concurrent_map_writer, &jobs[i]);
+        }
+        for (int i = 0; i < concurrent_map_threads; i++)
+            pthread_join(ids[i], NULL);
+        concurrent_map_checker check = m.for_each(concurrent_map_checker());
+        long counter = 0;
+        m.find(-1, counter);
+        std::cout << "threads: size " << m.size() << ", walked " << check.count
+                  << ", wrong " << check.wrong << ", counter " << counter << std::endl;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <pthread.h>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+# define CONCURRENT_STACK(T) locked_stack<T>
+
+// the standard library has no concurrent stack: a vector behind a mutex
+// pops in the same order when one thread drives it
+template <class T>
+class locked_stack {
+    private:
+        std::vector<T>          _values;
+        mutable pthread_mutex_t _lock;
+
+    public:
+        locked_stack() { pthread_mutex_init(&_lock, NULL); }
+        ~locked_stack() { pthread_mutex_destroy(&_lock); }
+
+        bool empty() const {
+            pthread_mutex_lock(&_lock);
+            bool empty = _values.empty();
+            pthread_mutex_unlock(&_lock);
+            return empty;
+        }
+
+        void push(const T &val) {
+            pthread_mutex_lock(&_lock);
+            _values.push_back(val);
+            pthread_mutex_unlock(&_lock);
+        }
+
+        bool pop(T &out) {
+            pthread_mutex_lock(&_lock);
+            bool found = !_values.empty();
+            if (found) {
+                out = _values.back();
+                _values.pop_back();
+            }
+            pthread_mutex_unlock(&_lock);
+            return found;
+        }
+
+        bool top(T &out) const {
+            pthread_mutex_lock(&_lock);
+            bool found = !_values.empty();
+            if (found)
+                out = _values.back();
+            pthread_mutex_unlock(&_lock);
+            return found;
+        }
+};
+#elif defined(USING_FT)
+# define NS ft
+# define CONCURRENT_STACK(T) ft::concurrent_stack<T>
+#include "concurrent_stack.hpp"
+#endif
+
+#ifdef NS
+
+typedef CONCURRENT_STACK(long) concurrent_stack_type;
+
+static const int  concurrent_stack_producers = 4;
+static const int  concurrent_stack_consumers = 3;
+static const long concurrent_stack_per_producer = 20000;
+
+struct concurrent_stack_job {
+    concurrent_stack_type *stack;
+    long                  *remaining;
+    int                   id;
+    std::vector<long>     popped;
+};
+
+static void *concurrent_stack_producer(void *arg) {
+    concurrent_stack_job *job = static_cast<concurrent_stack_job*>(arg);
+    for (long i = 0; i < concurrent_stack_per_producer; i++)
+        job->stack->push(job->id * concurrent_stack_per_producer + i);
+    return NULL;
+}
+
+// pops until every pushed value has been taken by some consumer
+static void *concurrent_stack_consumer(void *arg) {
+    concurrent_stack_job *job = static_cast<concurrent_stack_job*>(arg);
+    long                 value;
+    while (__atomic_load_n(job->remaining, __ATOMIC_RELAXED) > 0) {
+        if (job->stack->pop(value)) {
+            job->popped.push_back(value);
+            __atomic_sub_fetch(job->remaining, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+int concurrent_stack_test(void) {
+    std::cout << "concurrent stack test: \n";
+    {
+        concurrent_stack_type s;
+        long                  value = -1;
+        std::cout << s.empty() << ' ' << s.pop(value) << ' ' << s.top(value) << ' ' << value << std::endl;
+        for (long i = 1; i <= 5; i++)
+            s.push(i * 10);
+        s.top(value);
+        std::cout << s.empty() << ' ' << value << " |";
+        while (s.pop(value))
+            std::cout << ' ' << value;
+        std::cout << std::endl;
+        std::cout << s.empty() << std::endl;
+    }
+    {
+        // N producers and M consumers: what comes out is exactly what went in
+        concurrent_stack_type s;
+        long                  remaining = concurrent_stack_producers * concurrent_stack_per_producer;
+        pthread_t             ids[concurrent_stack_producers + concurrent_stack_consumers];
+        concurrent_stack_job  jobs[concurrent_stack_producers + concurrent_stack_consumers];
+        for (int i = 0; i < concurrent_stack_producers + concurrent_stack_consumers; i++) {
+            jobs[i].stack = &s;
+            jobs[i].remaining = &remaining;
+            jobs[i].id = i;
+            pthread_create(&ids[i], NULL, i < concurrent_stack_producers ? concurrent_stack_producer
+                                                                         : concurrent_stack_consumer, &jobs[i]);
+        }
+        for (int i = 0; i < concurrent_stack_producers + concurrent_stack_consumers; i++)
+            pthread_join(ids[i], NULL);
+        std::vector<long> popped;
+        for (int i = concurrent_stack_producers; i < concurrent_stack_producers + concurrent_stack_consumers; i++)
+            popped.insert(popped.end(), jobs[i].popped.begin(), jobs[i].popped.end());
+        std::sort(popped.begin(), popped.end());
+        bool same = popped.size() == size_t(concurrent_stack_producers * concurrent_stack_per_producer);
+        for (size_t i = 0; same && i < popped.size(); i++)
+            same = popped[i] == long(i);
+        std::cout << "threads: popped " << popped.size() << ", same as pushed " << same
+                  << ", empty " << s.empty() << std::endl;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <iostream>
+#include <vector>
+
+#if defined(USING_STD)
+# define NS std
+# define PAR
+# define PAR_ON(pool)
+# define REDUCE std::accumulate
+# define THREAD_POOL(name, threads)
+# define PARALLEL_FOR(pool, first, last, body) for (size_t i = first; i < last; i++) body(i)
+#include <algorithm>
+#include <numeric>
+#elif defined(USING_FT)
+# define NS ft
+# define PAR ft::execution::par,
+# define PAR_ON(pool) ft::execution::par.on(pool),
+# define REDUCE(first, last, init) ft::reduce(ft::execution::par_unseq, first, last, init)
+# define THREAD_POOL(name, threads) ft::thread_pool name(threads)
+# define PARALLEL_FOR(pool, first, last, body) ft::parallel_for(pool, first, last, body)
+#include "execution.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+#endif
+
+#ifdef NS
+
+struct execution_square {
+    long operator()(long x) const { return x * x; }
+};
+
+struct execution_is_odd {
+    bool operator()(long x) const { return x & 1; }
+};
+
+struct execution_add_one {
+    void operator()(long &x) const { x++; }
+};
+
+struct execution_greater {
+    bool operator()(long a, long b) const { return a > b; }
+};
+
+struct execution_triangle {
+    NS::vector<long> *out;
+    explicit execution_triangle(NS::vector<long> *pOut) : out(pOut) {}
+    void operator()(size_t i) const { (*out)[i] = long(i) * long(i + 1) / 2; }
+};
+
+int execution_test(void) {
+    std::cout << "execution policies test: \n";
+    NS::vector<long> v;
+    unsigned long    seed = 42;
+    for (int i = 0; i < 100000; i++) {
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        v.push_back((seed >> 33) % 1000);
+    }
+
+    NS::sort(PAR v.begin(), v.end());
+    std::cout << v[0] << ' ' << v[50000] << ' ' << v[99999] << std::endl;
+    NS::for_each(PAR v.begin(), v.end(), execution_add_one());
+    std::cout << REDUCE(v.begin(), v.end(), 0L) << std::endl;
+    std::cout << NS::count_if(PAR v.begin(), v.end(), execution_is_odd()) << std::endl;
+    std::cout << (NS::find(PAR v.begin(), v.end(), 500L) - v.begin()) << std::endl;
+
+    NS::vector<long> out(v.size());
+    NS::transform(PAR v.begin(), v.end(), out.begin(), execution_square());
+    std::cout << out[12345] << ' ' << out.back() << std::endl;
+    NS::fill(PAR out.begin(), out.begin() + 10, 7L);
+    NS::copy(PAR out.begin(), out.begin() + 20, v.begin());
+    NS::sort(PAR v.begin(), v.begin() + 20, execution_greater());
+    for (int i = 0; i < 20; i++)
+        std::cout << v[i] << ' ';
+    std::cout << std::endl;
+
+    THREAD_POOL(pool, 3);
+    NS::sort(PAR_ON(pool) out.begin(), out.end(), execution_greater());
+    std::cout << out[0] << ' ' << out[50000] << ' ' << out.back() << std::endl;
+    execution_triangle triangle(&out);
+    PARALLEL_FOR(pool, 0, out.size(), triangle);
+    std::cout << REDUCE(out.begin(), out.end(), 0L) << std::endl;
+    return 0;
+}
+
+#endif
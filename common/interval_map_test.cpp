@@ -0,0 +1,104 @@
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(USING_STD)
+# define NS std
+#include <map>
+typedef std::map<std::pair<int, int>, int> interval_map_type;
+# define INTERVAL(low, high) std::make_pair(low, high)
+# define LOW(it) (it)->first.first
+# define HIGH(it) (it)->first.second
+
+// what interval_map answers from its tree, found by a scan
+static void print_overlaps(interval_map_type &m, int low, int high, bool point) {
+    size_t n = 0;
+    for (interval_map_type::iterator it = m.begin(); it != m.end(); ++it) {
+        bool hit = point ? LOW(it) <= low && low < HIGH(it) : LOW(it) < high && low < HIGH(it);
+        if (hit) {
+            std::cout << " [" << LOW(it) << ',' << HIGH(it) << "):" << it->second;
+            n++;
+        }
+    }
+    std::cout << " (" << n << ')' << std::endl;
+}
+#elif defined(USING_FT)
+# define NS ft
+#include "interval_map.hpp"
+typedef ft::interval_map<int, int> interval_map_type;
+# define INTERVAL(low, high) ft::interval<int>(low, high)
+# define LOW(it) (it)->first.low
+# define HIGH(it) (it)->first.high
+
+// the first/next walk, checked against the single walk overlapping and
+// containing do on a const map; a mismatch prints a '!'
+static void print_overlaps(interval_map_type &m, int low, int high, bool point) {
+    const interval_map_type                     &cm = m;
+    std::vector<interval_map_type::iterator>       steps;
+    std::vector<interval_map_type::const_iterator> walk;
+    interval_map_type::iterator                    it;
+    if (point) {
+        for (it = m.first_containing(low); it != m.end(); it = m.next_containing(it, low))
+            steps.push_back(it);
+        cm.containing(low, std::back_inserter(walk));
+    }
+    else {
+        for (it = m.first_overlap(INTERVAL(low, high)); it != m.end(); it = m.next_overlap(it, INTERVAL(low, high)))
+            steps.push_back(it);
+        cm.overlapping(INTERVAL(low, high), std::back_inserter(walk));
+    }
+    for (size_t i = 0; i < steps.size(); i++)
+        std::cout << " [" << LOW(steps[i]) << ',' << HIGH(steps[i]) << "):" << steps[i]->second;
+    size_t n = point ? cm.count_containing(low) : cm.count_overlapping(INTERVAL(low, high));
+    bool   same = walk.size() == steps.size() && n == steps.size();
+    for (size_t i = 0; same && i < walk.size(); i++)
+        same = walk[i] == interval_map_type::const_iterator(steps[i]);
+    std::cout << " (" << n << ')' << (same ? "" : " !") << std::endl;
+}
+#endif
+
+#ifdef NS
+
+int interval_map_test(void) {
+    std::cout << "interval map test: \n";
+    interval_map_type m;
+    unsigned long     seed = 7;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+        int low = (seed >> 33) % 100000;
+        int length = (seed >> 20) % 64 + 1;
+        m[INTERVAL(low, low + length)] = i;
+    }
+    int k = 0;
+    for (interval_map_type::iterator it = m.begin(); it != m.end(); k++) {
+        if (k % 3 == 0)
+            m.erase(it++);
+        else
+            ++it;
+    }
+    m[INTERVAL(-10, 200000)] = -1;
+    m[INTERVAL(500, 500)] = -2;
+
+    std::cout << "size: " << m.size() << std::endl;
+    print_overlaps(m, 0, 100, false);
+    print_overlaps(m, 490, 510, false);
+    print_overlaps(m, 99990, 120000, false);
+    print_overlaps(m, 200000, 300000, false);
+    print_overlaps(m, 500, 0, true);
+    print_overlaps(m, 31337, 0, true);
+    print_overlaps(m, -10, 0, true);
+    print_overlaps(m, 200000, 0, true);
+
+    // a const map hands out const_iterators
+    const interval_map_type &cm = m;
+    long                    sum = 0;
+    for (interval_map_type::const_iterator cit = cm.begin(); cit != cm.end(); ++cit)
+        sum += cit->second;
+    interval_map_type::const_iterator found = cm.find(INTERVAL(500, 500));
+    std::cout << "const: sum " << sum << ", found " << found->second << ", missing "
+              << (cm.find(INTERVAL(1, 2)) == cm.end()) << ", last " << cm.rbegin()->second << std::endl;
+    return 0;
+}
+
+#endif
@@ -17,11 +17,37 @@ int main(void) {
     test_type_traits();
     lexicographical_compare_test();
     equal_test();
+    bulk_compare_test();
     pair_test();
     vector_test();
+    vector_bool_test();
+    vector_growth_test();
+    vector_mmap_test();
     stack_test();
+    circular_buffer_test();
     map_test();
+    map_find_many_test();
+    map_compact_test();
+    map_erase_if_test();
+    map_bulk_insert_test();
+    map_bounds_test();
+    map_erase_range_test();
     set_test();
+    set_algebra_test();
+    set_node_test();
+    set_bounds_test();
+    set_erase_range_test();
+    small_vector_test();
+    serialize_test();
+    concurrent_map_test();
+    rcu_map_test();
+    concurrent_stack_test();
+    mpmc_queue_test();
+    snapshot_test();
+    persistent_map_test();
+    interval_map_test();
+    split_map_test();
+    execution_test();
     return 0;
 #endif
 }
\ No newline at end of file
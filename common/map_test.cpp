@@ -3,11 +3,26 @@
 
 #if defined(USING_STD)
 # define NS std
+# define FIND_MANY(m, first, last, out) \
+  for (std::vector<int>::iterator k = first; k != last; ++k) *out++ = m.find(*k)
+# define COUNT_MANY(m, first, last, n) \
+  for (std::vector<int>::iterator k = first; k != last; ++k) n += m.count(*k)
+# define COMPACT(m)
+# define BULK_INSERT(m, first, last) m.insert(first, last)
+# define ERASE_IF(m, pred, n) \
+  for (NS::map<int, std::string>::iterator k = m.begin(); k != m.end();) \
+    if (pred(*k)) { m.erase(k++); n++; } else ++k
 #include <map>
 #elif defined(USING_FT)
 # define NS ft
+# define FIND_MANY(m, first, last, out) m.find_many(first, last, out)
+# define COUNT_MANY(m, first, last, n) n = m.count_many(first, last)
+# define COMPACT(m) m.compact()
+# define BULK_INSERT(m, first, last) m.bulk_insert(first, last)
+# define ERASE_IF(m, pred, n) n = NS::erase_if(m, pred)
 #include "map.hpp"
 #endif
+#include <vector>
 
 #ifdef NS
 
@@ -28,4 +43,202 @@ int map_test(void) {
   return 0;
 }
 
-#endif
\ No newline at end of file
+int map_find_many_test(void) {
+  std::cout << "map find_many test:\n";
+  NS::map<int, int> mp;
+  for (int i = 0; i < 1000; ++i)
+    mp[i * 3] = i;
+
+  typedef NS::map<int, int>::iterator iterator;
+  std::vector<int>      keys;
+  std::vector<iterator> found;
+  for (int i = 0; i < 100; ++i)
+    keys.push_back((i * 37) % 3100 - 50);
+  std::back_insert_iterator<std::vector<iterator> > out(found);
+  FIND_MANY(mp, keys.begin(), keys.end(), out);
+  size_t n = 0;
+  COUNT_MANY(mp, keys.begin(), keys.end(), n);
+
+  std::cout << found.size() << ' ' << n << std::endl;
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (found[i] == mp.end())
+      std::cout << '-' << ' ';
+    else
+      std::cout << found[i]->first << ':' << found[i]->second << ' ';
+  }
+  std::cout << std::endl;
+  return 0;
+}
+
+int map_compact_test(void) {
+  std::cout << "map compact test:\n";
+  NS::map<int, std::string> mp;
+  for (int i = 0; i < 2000; ++i)
+    mp[(i * 7) % 2003] = std::string(i % 17, 'a' + i % 26);
+  for (int i = 0; i < 2000; i += 3)
+    mp.erase((i * 7) % 2003);
+  COMPACT(mp);
+
+  for (int i = 0; i < 300; ++i)
+    mp.erase(i * 5);
+  for (int i = 0; i < 300; ++i)
+    mp[i * 11] += 'z';
+  COMPACT(mp);
+
+  size_t sum = 0;
+  for (NS::map<int, std::string>::iterator it = mp.begin(); it != mp.end(); ++it)
+    sum += it->first * it->second.size();
+  std::cout << mp.size() << ' ' << sum << ' ' << mp.begin()->first << ' ' << (--mp.end())->first << std::endl;
+  return 0;
+}
+
+static bool odd_length(NS::pair<const int, std::string> const &p) {
+  return p.second.size() % 2 != 0;
+}
+
+int map_erase_if_test(void) {
+  std::cout << "map erase_if test:\n";
+  NS::map<int, std::string> mp;
+  for (int i = 0; i < 1000; ++i)
+    mp[(i * 13) % 1009] = std::string(i % 11, 'a' + i % 26);
+  size_t erased = 0;
+  ERASE_IF(mp, odd_length, erased);
+  mp.erase(mp.find(6), mp.find(400));
+
+  size_t sum = 0;
+  for (NS::map<int, std::string>::iterator it = mp.begin(); it != mp.end(); ++it)
+    sum += it->first * it->second.size();
+  std::cout << erased << ' ' << mp.size() << ' ' << sum << ' ' << mp.begin()->first << ' ' << (--mp.end())->first << std::endl;
+  return 0;
+}
+
+int map_bulk_insert_test(void) {
+  std::cout << "map bulk_insert test:\n";
+  NS::map<int, int> mp;
+  for (int i = 0; i < 500; ++i)
+    mp[i * 4 - 1000] = i;
+
+  // unsorted, with repeats: the first of equal keys wins, as with insert
+  std::vector<NS::pair<int, int> > batch;
+  for (int i = 0; i < 3000; ++i)
+    batch.push_back(NS::make_pair((i * 7919) % 2011 - 1000, -i));
+  BULK_INSERT(mp, batch.begin(), batch.begin() + 40);
+  BULK_INSERT(mp, batch.begin(), batch.end());
+
+  long sum = 0;
+  for (NS::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+    sum += it->first * 3 + it->second;
+  std::cout << mp.size() << ' ' << sum << ' ' << mp.begin()->first << ' ' << (--mp.end())->first << std::endl;
+  return 0;
+}
+
+
+// ft has no greater
+struct reverse_int_order {
+  bool operator()(int lhs, int rhs) const { return rhs < lhs; }
+};
+
+template <class M>
+static void print_bound(M &mp, typename M::const_iterator it) {
+  if (it == mp.end())
+    std::cout << " end";
+  else
+    std::cout << ' ' << it->first;
+}
+
+// every bound against the keys present, between them, and past either end
+template <class M>
+static void print_bounds(M &mp, const int *keys, size_t n) {
+  const M &cmp = mp;
+  for (size_t i = 0; i < n; ++i) {
+    int k = keys[i];
+    std::cout << k << ':';
+    print_bound(mp, mp.lower_bound(k));
+    print_bound(mp, mp.upper_bound(k));
+    NS::pair<typename M::iterator, typename M::iterator> range = mp.equal_range(k);
+    print_bound(mp, range.first);
+    print_bound(mp, range.second);
+    print_bound(mp, cmp.lower_bound(k));
+    print_bound(mp, cmp.upper_bound(k));
+    std::cout << ' ' << mp.count(k) << std::endl;
+  }
+}
+
+int map_bounds_test(void) {
+  std::cout << "map bounds test:\n";
+  static const int    keys[] = {-100, 9, 10, 11, 99, 100, 101, 198, 200, 201, 1000};
+  static const size_t n = sizeof(keys) / sizeof(keys[0]);
+
+  NS::map<int, std::string> empty;
+  print_bounds(empty, keys, 2);
+  NS::map<int, std::string> mp;
+  for (int k = 10; k <= 200; k += 2)
+    mp[k] = std::string(k % 7, 'x');
+  print_bounds(mp, keys, n);
+  NS::map<int, std::string> one;
+  one[100] = "one";
+  print_bounds(one, keys, n);
+  // with the order reversed the bounds move the other way
+  NS::map<int, int, reverse_int_order> rev;
+  for (int k = 10; k <= 200; k += 2)
+    rev[k] = k;
+  print_bounds(rev, keys, n);
+  return 0;
+}
+
+static void print_keys(NS::map<int, int> &mp) {
+  std::cout << "size: " << mp.size() << " |";
+  int  last = 0;
+  bool ordered = true;
+  for (NS::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it) {
+    ordered = ordered && (it == mp.begin() || last < it->first);
+    last = it->first;
+    std::cout << ' ' << it->first << ':' << it->second;
+  }
+  std::cout << (ordered ? "" : " out of order") << std::endl;
+}
+
+static void fill_keys(NS::map<int, int> &mp, int n) {
+  mp.clear();
+  for (int i = 0; i < n; ++i)
+    mp[(i * 7) % n] = i;
+}
+
+int map_erase_range_test(void) {
+  std::cout << "map erase range test:\n";
+  NS::map<int, int> mp;
+  fill_keys(mp, 20);
+  mp.erase(mp.find(5), mp.find(5));
+  print_keys(mp);
+  mp.erase(mp.end(), mp.end());
+  print_keys(mp);
+  mp.erase(mp.find(7), mp.find(8));
+  print_keys(mp);
+  mp.erase(mp.find(3), mp.find(12));
+  print_keys(mp);
+  mp.erase(mp.find(15), mp.end());
+  print_keys(mp);
+  mp.erase(mp.begin(), mp.find(2));
+  print_keys(mp);
+  mp.erase(mp.begin(), mp.end());
+  print_keys(mp);
+  mp.erase(mp.begin(), mp.end());
+  print_keys(mp);
+
+  // bigger trees, cut at every position, still balanced enough to reuse
+  for (int n = 1; n <= 64; n *= 4) {
+    for (int first = 0; first <= n; first += 3) {
+      fill_keys(mp, n);
+      NS::map<int, int>::iterator from = mp.lower_bound(first);
+      NS::map<int, int>::iterator to = mp.lower_bound(first + n / 3);
+      mp.erase(from, to);
+      mp[first] = -1;
+      mp[n + 1] = -2;
+      std::cout << n << ' ' << first << ": ";
+      print_keys(mp);
+    }
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+# define MPMC_QUEUE(T) locked_queue<T>
+
+// the standard library has no bounded concurrent queue: a deque behind a
+// mutex, its capacity rounded up the way the ring rounds it
+template <class T>
+class locked_queue {
+    private:
+        std::deque<T>           _values;
+        size_t                  _capacity;
+        mutable pthread_mutex_t _lock;
+
+    public:
+        explicit locked_queue(size_t capacity) : _capacity(2) {
+            while (_capacity < capacity)
+                _capacity <<= 1;
+            pthread_mutex_init(&_lock, NULL);
+        }
+
+        ~locked_queue() { pthread_mutex_destroy(&_lock); }
+
+        size_t capacity() const { return _capacity; }
+
+        size_t size() const {
+            pthread_mutex_lock(&_lock);
+            size_t size = _values.size();
+            pthread_mutex_unlock(&_lock);
+            return size;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        bool push(const T &val) {
+            pthread_mutex_lock(&_lock);
+            bool room = _values.size() < _capacity;
+            if (room)
+                _values.push_back(val);
+            pthread_mutex_unlock(&_lock);
+            return room;
+        }
+
+        bool pop(T &out) {
+            pthread_mutex_lock(&_lock);
+            bool found = !_values.empty();
+            if (found) {
+                out = _values.front();
+                _values.pop_front();
+            }
+            pthread_mutex_unlock(&_lock);
+            return found;
+        }
+
+        bool front(T &out) const {
+            pthread_mutex_lock(&_lock);
+            bool found = !_values.empty();
+            if (found)
+                out = _values.front();
+            pthread_mutex_unlock(&_lock);
+            return found;
+        }
+};
+#elif defined(USING_FT)
+# define NS ft
+# define MPMC_QUEUE(T) ft::mpmc_queue<T>
+#include "mpmc_queue.hpp"
+#endif
+
+#ifdef NS
+
+typedef MPMC_QUEUE(long) mpmc_queue_type;
+
+static const int  mpmc_queue_producers = 3;
+static const int  mpmc_queue_consumers = 4;
+static const long mpmc_queue_per_producer = 20000;
+
+struct mpmc_queue_job {
+    mpmc_queue_type   *queue;
+    long              *remaining;
+    int               id;
+    std::vector<long> popped;
+};
+
+// the queue is much smaller than what goes through it, producers wait for
+// room
+static void *mpmc_queue_producer(void *arg) {
+    mpmc_queue_job *job = static_cast<mpmc_queue_job*>(arg);
+    for (long i = 0; i < mpmc_queue_per_producer; i++)
+        while (!job->queue->push(job->id * mpmc_queue_per_producer + i))
+            sched_yield();
+    return NULL;
+}
+
+static void *mpmc_queue_consumer(void *arg) {
+    mpmc_queue_job *job = static_cast<mpmc_queue_job*>(arg);
+    long           value;
+    while (__atomic_load_n(job->remaining, __ATOMIC_RELAXED) > 0) {
+        if (job->queue->pop(value)) {
+            job->popped.push_back(value);
+            __atomic_sub_fetch(job->remaining, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+int mpmc_queue_test(void) {
+    std::cout << "mpmc queue test: \n";
+    {
+        mpmc_queue_type q(5);
+        long            value = -1;
+        std::cout << q.capacity() << ' ' << q.empty() << ' ' << q.pop(value) << ' '
+                  << q.front(value) << ' ' << value << std::endl;
+        long pushed = 0;
+        while (q.push(pushed * 10))
+            pushed++;
+        q.front(value);
+        std::cout << "pushed " << pushed << ", size " << q.size() << ", front " << value << " |";
+        for (int i = 0; i < 3 && q.pop(value); i++)
+            std::cout << ' ' << value;
+        q.push(100);
+        q.front(value);
+        std::cout << " | front " << value << " |";
+        while (q.pop(value))
+            std::cout << ' ' << value;
+        std::cout << std::endl;
+        std::cout << q.empty() << ' ' << q.size() << std::endl;
+    }
+    {
+        // N producers and M consumers: what comes out is exactly what went
+        // in, and each producer's values come out in the order it pushed
+        mpmc_queue_type q(1000);
+        long            remaining = mpmc_queue_producers * mpmc_queue_per_producer;
+        pthread_t       ids[mpmc_queue_producers + mpmc_queue_consumers];
+        mpmc_queue_job  jobs[mpmc_queue_producers + mpmc_queue_consumers];
+        for (int i = 0; i < mpmc_queue_producers + mpmc_queue_consumers; i++) {
+            jobs[i].queue = &q;
+            jobs[i].remaining = &remaining;
+            jobs[i].id = i;
+            pthread_create(&ids[i], NULL, i < mpmc_queue_producers ? mpmc_queue_producer
+                                                                   : mpmc_queue_consumer, &jobs[i]);
+        }
+        for (int i = 0; i < mpmc_queue_producers + mpmc_queue_consumers; i++)
+            pthread_join(ids[i], NULL);
+        std::vector<long> popped;
+        bool              ordered = true;
+        for (int i = mpmc_queue_producers; i < mpmc_queue_producers + mpmc_queue_consumers; i++) {
+            std::vector<long> last(mpmc_queue_producers, -1);
+            for (size_t j = 0; j < jobs[i].popped.size(); j++) {
+                long value = jobs[i].popped[j];
+                ordered = ordered && value > last[value / mpmc_queue_per_producer];
+                last[value / mpmc_queue_per_producer] = value;
+            }
+            popped.insert(popped.end(), jobs[i].popped.begin(), jobs[i].popped.end());
+        }
+        std::sort(popped.begin(), popped.end());
+        bool same = popped.size() == size_t(mpmc_queue_producers * mpmc_queue_per_producer);
+        for (size_t i = 0; same && i < popped.size(); i++)
+            same = popped[i] == long(i);
+        std::cout << "threads: popped " << popped.size() << ", same as pushed " << same
+                  << ", in order per producer " << ordered << ", empty " << q.empty() << std::endl;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <string>
+
+#if defined(USING_STD)
+# define NS std
+# define PERSISTENT_MAP(K, T) std::map<K, T>
+#include <map>
+#elif defined(USING_FT)
+# define NS ft
+# define PERSISTENT_MAP(K, T) ft::persistent_map<K, T>
+#include "persistent_map.hpp"
+#endif
+
+#ifdef NS
+
+template <class M>
+static void print_map(const M &m) {
+    std::cout << "size: " << m.size() << " |";
+    for (typename M::const_iterator it = m.begin(); it != m.end(); ++it)
+        std::cout << ' ' << it->first << ':' << it->second;
+    std::cout << std::endl;
+}
+
+int persistent_map_test(void) {
+    std::cout << "persistent map test: \n";
+    PERSISTENT_MAP(int, std::string) m;
+    for (int i = 0; i < 20; i++)
+        m.insert(NS::make_pair((i * 7) % 20, std::string(i % 3 + 1, 'a' + i)));
+
+    // snapshots stay as they were while the original changes
+    PERSISTENT_MAP(int, std::string) v1(m);
+    for (int i = 0; i < 20; i += 3)
+        m.erase(i);
+    PERSISTENT_MAP(int, std::string) v2(m);
+    m.insert(NS::make_pair(100, "new"));
+    m.insert(NS::make_pair(1, "dup"));
+    m.clear();
+    m.insert(NS::make_pair(5, "five"));
+
+    print_map(v1);
+    print_map(v2);
+    print_map(m);
+    std::cout << v1.count(3) << ' ' << v2.count(3) << ' ' << v2.at(4) << ' '
+              << v2.lower_bound(9)->first << ' ' << v2.upper_bound(10)->first << ' '
+              << (v1.find(42) == v1.end()) << ' ' << v2.rbegin()->first << std::endl;
+    std::cout << (v1 == v2) << ' ' << (v2 < v1) << ' ' << (m != m) << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+# define RCU_MAP(K, T) versioned_map<K, T>
+#include <map>
+#include <vector>
+
+// the standard library has no rcu map: every update copies the whole map,
+// a version a reader is walking is kept until it is done with it. Enough
+// for the single reader below
+template <class Key, class T>
+class versioned_map {
+    private:
+        typedef std::map<Key, T> map_type;
+
+        map_type                *_current;
+        map_type                *_held;
+        std::vector<map_type*>  _retired;
+        mutable pthread_mutex_t _lock;
+
+        versioned_map(versioned_map const &);
+        versioned_map &operator=(versioned_map const &);
+
+        void _publish(map_type *next) {
+            pthread_mutex_lock(&_lock);
+            _retired.push_back(_current);
+            _current = next;
+            pthread_mutex_unlock(&_lock);
+            reclaim();
+        }
+
+    public:
+        class reader {
+            private:
+                versioned_map *_map;
+
+            public:
+                explicit reader(versioned_map &m) : _map(&m) {}
+
+                template <class Function>
+                Function for_each(Function f) const {
+                    pthread_mutex_lock(&_map->_lock);
+                    map_type *version = _map->_current;
+                    _map->_held = version;
+                    pthread_mutex_unlock(&_map->_lock);
+                    for (typename map_type::const_iterator it = version->begin(); it != version->end(); ++it)
+                        f(*it);
+                    pthread_mutex_lock(&_map->_lock);
+                    _map->_held = NULL;
+                    pthread_mutex_unlock(&_map->_lock);
+                    return f;
+                }
+        };
+
+        versioned_map() : _current(new map_type), _held(NULL) { pthread_mutex_init(&_lock, NULL); }
+
+        ~versioned_map() {
+            delete _current;
+            for (size_t i = 0; i < _retired.size(); i++)
+                delete _retired[i];
+            pthread_mutex_destroy(&_lock);
+        }
+
+        size_t size() const { return _current->size(); }
+
+        bool insert(const std::pair<const Key, T> &val) {
+            if (_current->count(val.first))
+                return false;
+            map_type *next = new map_type(*_current);
+            next->insert(val);
+            _publish(next);
+            return true;
+        }
+
+        bool insert_or_assign(const Key &k, const T &obj) {
+            bool     added = !_current->count(k);
+            map_type *next = new map_type(*_current);
+            (*next)[k] = obj;
+            _publish(next);
+            return added;
+        }
+
+        size_t erase(const Key &k) {
+            if (!_current->count(k))
+                return 0;
+            map_type *next = new map_type(*_current);
+            next->erase(k);
+            _publish(next);
+            return 1;
+        }
+
+        bool find(const Key &k, T &out) const {
+            typename map_type::const_iterator it = _current->find(k);
+            if (it == _current->end())
+                return false;
+            out = it->second;
+            return true;
+        }
+
+        size_t reclaim() {
+            pthread_mutex_lock(&_lock);
+            size_t kept = 0;
+            for (size_t i = 0; i < _retired.size(); i++) {
+                if (_retired[i] == _held)
+                    _retired[kept++] = _retired[i];
+                else
+                    delete _retired[i];
+            }
+            _retired.resize(kept);
+            pthread_mutex_unlock(&_lock);
+            return kept;
+        }
+};
+#elif defined(USING_FT)
+# define NS ft
+# define RCU_MAP(K, T) ft::rcu_map<K, T>
+#include "rcu_map.hpp"
+#endif
+
+#ifdef NS
+
+typedef RCU_MAP(int, long) rcu_map_type;
+
+// set by the reader once it is inside a version, by the writer once it has
+// replaced that version
+static int rcu_map_entered;
+static int rcu_map_updated;
+
+// sums a version, stopping on the first element until the writer is done
+struct rcu_map_holder {
+    long count;
+    long sum;
+    rcu_map_holder() : count(0), sum(0) {}
+    void operator()(const NS::pair<const int, long> &val) {
+        if (count++ == 0) {
+            __atomic_store_n(&rcu_map_entered, 1, __ATOMIC_RELEASE);
+            while (!__atomic_load_n(&rcu_map_updated, __ATOMIC_ACQUIRE))
+                sched_yield();
+        }
+        sum += val.first * 1000L + val.second;
+    }
+};
+
+struct rcu_map_job {
+    rcu_map_type   *map;
+    rcu_map_holder result;
+};
+
+static void *rcu_map_reader(void *arg) {
+    rcu_map_job          *job = static_cast<rcu_map_job*>(arg);
+    rcu_map_type::reader reader(*job->map);
+    job->result = reader.for_each(rcu_map_holder());
+    return NULL;
+}
+
+int rcu_map_test(void) {
+    std::cout << "rcu map test: \n";
+    rcu_map_type m;
+    for (int i = 0; i < 100; i++)
+        m.insert(NS::make_pair(i, long(i)));
+    std::cout << "retired before: " << m.reclaim() << std::endl;
+
+    rcu_map_job job;
+    job.map = &m;
+    pthread_t id;
+    pthread_create(&id, NULL, rcu_map_reader, &job);
+    while (!__atomic_load_n(&rcu_map_entered, __ATOMIC_ACQUIRE))
+        sched_yield();
+
+    // the reader is inside the old version: replace it several times over
+    for (int i = 0; i < 100; i += 2)
+        m.erase(i);
+    m.insert_or_assign(1, 111);
+    m.insert(NS::make_pair(500, 5L));
+    long value = 0;
+    m.find(1, value);
+    std::cout << "writer sees: size " << m.size() << ", 1:" << value << ", has 0 " << m.find(0, value) << std::endl;
+    std::cout << "old versions kept while read: " << (m.reclaim() > 0) << std::endl;
+    __atomic_store_n(&rcu_map_updated, 1, __ATOMIC_RELEASE);
+    pthread_join(id, NULL);
+
+    // the reader walked the version it entered, all of it
+    std::cout << "reader saw: count " << job.result.count << ", sum " << job.result.sum << std::endl;
+    std::cout << "retired after: " << m.reclaim() << std::endl;
+
+    rcu_map_type::reader reader(m);
+    rcu_map_holder       now = reader.for_each(rcu_map_holder());
+    std::cout << "new version: count " << now.count << ", sum " << now.sum << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <set>
+
+// the standard library has no serializer: a text stream (the count, the
+// elements, then "end") stands in for the binary one, damaged the same
+// ways and rejected the same way
+template <class T>
+static void write_value(std::ostream &out, const T &value) {
+    out << ' ' << value;
+}
+
+template <class K, class T>
+static void write_value(std::ostream &out, const std::pair<const K, T> &value) {
+    out << ' ' << value.first << ' ' << value.second;
+}
+
+template <class T>
+static bool read_value(std::istream &in, T &value) {
+    return static_cast<bool>(in >> value);
+}
+
+template <class K, class T>
+static bool read_value(std::istream &in, std::pair<K, T> &value) {
+    return static_cast<bool>(in >> value.first >> value.second);
+}
+
+template <class C>
+static void write_text(std::ostream &out, const C &c) {
+    out << c.size();
+    for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+        write_value(out, *it);
+    out << " end";
+}
+
+template <class C, class V>
+static void read_text(std::istream &in, C &c) {
+    uint64_t    count;
+    std::string end;
+    C           read;
+    if (!(in >> count))
+        throw std::runtime_error("deserialize: bad header");
+    for (uint64_t i = 0; i < count; i++) {
+        V value;
+        if (!read_value(in, value))
+            throw std::runtime_error("deserialize: unexpected end of stream");
+        read.insert(read.end(), value);
+    }
+    if (!(in >> end) || end != "end")
+        throw std::runtime_error("deserialize: trailing records");
+    c.swap(read);
+}
+
+template <class T>
+static void serialize(std::ostream &out, const std::vector<T> &v) {
+    write_text(out, v);
+}
+
+template <class T>
+static void deserialize(std::istream &in, std::vector<T> &v) {
+    read_text<std::vector<T>, T>(in, v);
+}
+
+template <class K, class T>
+static void serialize(std::ostream &out, const std::map<K, T> &m) {
+    write_text(out, m);
+}
+
+template <class K, class T>
+static void deserialize(std::istream &in, std::map<K, T> &m) {
+    read_text<std::map<K, T>, std::pair<K, T> >(in, m);
+}
+
+template <class T>
+static void serialize(std::ostream &out, const std::set<T> &s) {
+    write_text(out, s);
+}
+
+template <class T>
+static void deserialize(std::istream &in, std::set<T> &s) {
+    read_text<std::set<T>, T>(in, s);
+}
+
+static void corrupt_count(std::string &stream, uint64_t count) {
+    std::ostringstream out;
+    out << count;
+    stream.replace(0, stream.find(' '), out.str());
+}
+
+static void corrupt_magic(std::string &stream) {
+    stream.insert(0, "x");
+}
+
+template <class M, class Iterator>
+static void assign_sorted(M &m, Iterator first, size_t n) {
+    M read;
+    for (size_t i = 0; i < n; i++, ++first) {
+        if (!read.empty() && !read.key_comp()(read.rbegin()->first, first->first))
+            throw std::invalid_argument("buildSorted: values not strictly ascending");
+        read.insert(read.end(), *first);
+    }
+    m.swap(read);
+}
+#elif defined(USING_FT)
+# define NS ft
+#include "serialize.hpp"
+
+static void corrupt_count(std::string &stream, uint64_t count) {
+    std::memcpy(&stream[offsetof(ft::detail::serial_header, count)], &count, sizeof(count));
+}
+
+static void corrupt_magic(std::string &stream) {
+    stream[0] = 'x';
+}
+
+template <class M, class Iterator>
+static void assign_sorted(M &m, Iterator first, size_t n) {
+    m.assign_sorted(first, n);
+}
+#endif
+
+#ifdef NS
+
+template <class C>
+static void print_map(C &m) {
+    std::cout << "size: " << m.size() << " |";
+    for (typename C::iterator it = m.begin(); it != m.end(); ++it)
+        std::cout << ' ' << it->first << ':' << it->second;
+    std::cout << std::endl;
+}
+
+template <class C>
+static void print_values(C &c) {
+    std::cout << "size: " << c.size() << " |";
+    for (typename C::iterator it = c.begin(); it != c.end(); ++it)
+        std::cout << ' ' << *it;
+    std::cout << std::endl;
+}
+
+template <class C>
+static std::string serialized(const C &c) {
+    std::ostringstream out;
+    serialize(out, c);
+    return out.str();
+}
+
+// a damaged stream must throw and leave the target as it was
+template <class C>
+static void reject(const char *name, const std::string &stream, C &target) {
+    std::istringstream in(stream);
+    std::cout << name << ": ";
+    try {
+        deserialize(in, target);
+        std::cout << "accepted" << std::endl;
+    }
+    catch (std::runtime_error &) {
+        std::cout << "rejected" << std::endl;
+    }
+}
+
+int serialize_test(void) {
+    std::cout << "serialize test: \n";
+    // round trips, the vector spans several chunks
+    NS::vector<int> v;
+    for (int i = 0; i < 600000; i++)
+        v.push_back(i * 7 - 1000);
+    NS::vector<int> v2(3, 42);
+    std::istringstream vin(serialized(v));
+    deserialize(vin, v2);
+    std::cout << "vector: size " << v2.size() << ", same " << (v == v2) << std::endl;
+
+    NS::vector<int> emptyVector;
+    std::istringstream ein(serialized(emptyVector));
+    deserialize(ein, v2);
+    std::cout << "empty vector: size " << v2.size() << std::endl;
+
+    // packed bits, the last word only partly used
+    NS::vector<bool> bits;
+    for (int i = 0; i < 100003; i++)
+        bits.push_back(i % 3 == 0 || i % 7 == 0);
+    NS::vector<bool> bits2(5, true);
+    std::istringstream bin(serialized(bits));
+    deserialize(bin, bits2);
+    std::cout << "vector<bool>: size " << bits2.size() << ", same " << (bits == bits2) << std::endl;
+
+    NS::map<int, int> m;
+    for (int i = 0; i < 1000; i++)
+        m[(i * 37) % 1000] = i;
+    NS::map<int, int> m2;
+    m2[-1] = -1;
+    std::istringstream min(serialized(m));
+    deserialize(min, m2);
+    std::cout << "map: size " << m2.size() << ", same "
+              << (m.size() == m2.size() && NS::equal(m.begin(), m.end(), m2.begin())) << std::endl;
+
+    NS::set<long> s;
+    for (long i = 0; i < 50; i++)
+        s.insert(i * i % 47);
+    NS::set<long> s2;
+    std::istringstream sin(serialized(s));
+    deserialize(sin, s2);
+    print_values(s2);
+
+    // damaged streams
+    NS::vector<int> vtarget(3, 42);
+    NS::map<int, int> mtarget;
+    mtarget[1] = 10;
+    mtarget[2] = 20;
+    NS::set<long> starget;
+    starget.insert(7);
+
+    std::string stream = serialized(v);
+    stream.resize(stream.size() / 2);
+    reject("truncated vector", stream, vtarget);
+    stream = serialized(bits);
+    stream.resize(stream.size() / 2);
+    reject("truncated vector<bool>", stream, bits2);
+    stream = serialized(m);
+    stream.resize(stream.size() / 2);
+    reject("truncated map", stream, mtarget);
+    stream = serialized(s);
+    stream.resize(stream.size() - 2);
+    reject("truncated set", stream, starget);
+
+    stream = serialized(v);
+    corrupt_count(stream, (uint64_t)1 << 60);
+    reject("vector count 2^60", stream, vtarget);
+    stream = serialized(m);
+    corrupt_count(stream, (uint64_t)1 << 60);
+    reject("map count 2^60", stream, mtarget);
+    stream = serialized(m);
+    corrupt_count(stream, 5);
+    reject("map count too small", stream, mtarget);
+    stream = serialized(s);
+    corrupt_magic(stream);
+    reject("set bad magic", stream, starget);
+
+    print_values(vtarget);
+    std::cout << "vector<bool> kept: size " << bits2.size() << ", same " << (bits == bits2) << std::endl;
+    print_map(mtarget);
+    print_values(starget);
+
+    // assign_sorted takes nothing out of order and keeps what it had
+    NS::vector<NS::pair<int, int> > sorted;
+    sorted.push_back(NS::make_pair(1, 1));
+    sorted.push_back(NS::make_pair(3, 3));
+    sorted.push_back(NS::make_pair(2, 2));
+    sorted.push_back(NS::make_pair(4, 4));
+    try {
+        assign_sorted(mtarget, sorted.begin(), sorted.size());
+        std::cout << "unsorted: accepted" << std::endl;
+    }
+    catch (std::invalid_argument &) {
+        std::cout << "unsorted: rejected" << std::endl;
+    }
+    sorted[2].first = 3;
+    try {
+        assign_sorted(mtarget, sorted.begin(), sorted.size());
+        std::cout << "duplicate: accepted" << std::endl;
+    }
+    catch (std::invalid_argument &) {
+        std::cout << "duplicate: rejected" << std::endl;
+    }
+    print_map(mtarget);
+    assign_sorted(mtarget, sorted.begin(), 2);
+    print_map(mtarget);
+    return 0;
+}
+
+#endif
@@ -3,10 +3,33 @@
 
 #if defined(USING_STD)
 # define NS std
+# define THREAD_POOL(name, threads)
+# define SET_ALGEBRA(op, ft_op, lhs, rhs) do { \
+    std::set<int> out; \
+    std::op(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(out, out.begin())); \
+    lhs.swap(out); \
+    rhs.clear(); \
+  } while (0)
+# define SET_ALGEBRA_ON(pool, op, ft_op, lhs, rhs) SET_ALGEBRA(op, ft_op, lhs, rhs)
+# define MOVE_NODE(from, to, k) do { if (from.erase(k)) to.insert(k); } while (0)
+# define MERGE(to, from) do { \
+    std::set<int> kept; \
+    for (std::set<int>::iterator it = from.begin(); it != from.end(); ++it) \
+      if (!to.insert(*it).second) kept.insert(*it); \
+    from.swap(kept); \
+  } while (0)
 #include <set>
+#include <algorithm>
+#include <iterator>
 #elif defined(USING_FT)
 # define NS ft
+# define THREAD_POOL(name, threads) ft::thread_pool name(threads)
+# define SET_ALGEBRA(op, ft_op, lhs, rhs) ft::ft_op(lhs, rhs)
+# define SET_ALGEBRA_ON(pool, op, ft_op, lhs, rhs) ft::ft_op(pool, lhs, rhs)
+# define MOVE_NODE(from, to, k) do { ft::set<int>::node_type nh = from.extract(k); to.insert(nh); } while (0)
+# define MERGE(to, from) to.merge(from)
 #include "set.hpp"
+#include "parallel_set_algebra.hpp"
 #endif
 
 #ifdef NS
@@ -27,4 +50,151 @@ int set_test ()
   return 0;
 }
 
-#endif
\ No newline at end of file
+static void set_algebra_fill(NS::set<int> &lhs, NS::set<int> &rhs, int n) {
+  lhs.clear();
+  rhs.clear();
+  for (int i = 0; i < n; ++i) lhs.insert(i * 2);
+  for (int i = 0; i < n; ++i) rhs.insert(i * 3);
+}
+
+static void set_algebra_print(NS::set<int> &lhs, NS::set<int> &rhs) {
+  long sum = 0;
+  for (NS::set<int>::iterator it = lhs.begin(); it != lhs.end(); ++it)
+    sum += *it;
+  std::cout << lhs.size() << ' ' << sum << ' ' << rhs.size();
+  if (!lhs.empty())
+    std::cout << ' ' << *lhs.begin() << ' ' << *--lhs.end();
+  std::cout << std::endl;
+}
+
+int set_algebra_test ()
+{
+  std::cout << "set algebra test:\n";
+  NS::set<int> lhs;
+  NS::set<int> rhs;
+  THREAD_POOL(pool, 4);
+
+  set_algebra_fill(lhs, rhs, 10000);
+  SET_ALGEBRA(set_union, merge_union, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_fill(lhs, rhs, 10000);
+  SET_ALGEBRA(set_intersection, retain_intersection, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_fill(lhs, rhs, 10000);
+  SET_ALGEBRA(set_difference, remove_difference, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_fill(rhs, lhs, 10000);
+  SET_ALGEBRA(set_difference, remove_difference, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+
+  set_algebra_fill(lhs, rhs, 100000);
+  SET_ALGEBRA_ON(pool, set_union, merge_union, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_fill(lhs, rhs, 100000);
+  SET_ALGEBRA_ON(pool, set_intersection, retain_intersection, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_fill(lhs, rhs, 100000);
+  SET_ALGEBRA_ON(pool, set_difference, remove_difference, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+
+  set_algebra_fill(lhs, rhs, 100);
+  lhs.clear();
+  SET_ALGEBRA(set_union, merge_union, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  SET_ALGEBRA(set_intersection, retain_intersection, lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  return 0;
+}
+
+int set_node_test ()
+{
+  std::cout << "set node test:\n";
+  NS::set<int> lhs;
+  NS::set<int> rhs;
+
+  set_algebra_fill(lhs, rhs, 1000);
+  for (int k = 0; k < 3000; k += 7)
+    MOVE_NODE(lhs, rhs, k);
+  set_algebra_print(lhs, rhs);
+  set_algebra_print(rhs, lhs);
+  MERGE(lhs, rhs);
+  set_algebra_print(lhs, rhs);
+  set_algebra_print(rhs, lhs);
+  MERGE(rhs, lhs);
+  set_algebra_print(rhs, lhs);
+  return 0;
+}
+
+static void print_set_bound(NS::set<int> &st, NS::set<int>::const_iterator it) {
+  if (it == st.end())
+    std::cout << " end";
+  else
+    std::cout << ' ' << *it;
+}
+
+int set_bounds_test ()
+{
+  std::cout << "set bounds test:\n";
+  static const int    keys[] = {-7, 0, 2, 3, 149, 150, 151, 297, 298, 299, 5000};
+  static const size_t n = sizeof(keys) / sizeof(keys[0]);
+  NS::set<int> st;
+  for (int k = 2; k <= 298; k += 3)
+    st.insert(k);
+
+  for (int round = 0; round < 2; ++round) {
+    const NS::set<int> &cst = st;
+    for (size_t i = 0; i < n; ++i) {
+      std::cout << keys[i] << ':';
+      print_set_bound(st, st.lower_bound(keys[i]));
+      print_set_bound(st, st.upper_bound(keys[i]));
+      NS::pair<NS::set<int>::iterator, NS::set<int>::iterator> range = st.equal_range(keys[i]);
+      print_set_bound(st, range.first);
+      print_set_bound(st, range.second);
+      print_set_bound(st, cst.lower_bound(keys[i]));
+      print_set_bound(st, cst.upper_bound(keys[i]));
+      std::cout << ' ' << st.count(keys[i]) << std::endl;
+    }
+    // and again once the set holds a single element
+    st.clear();
+    st.insert(150);
+  }
+  return 0;
+}
+
+static void set_erase_print(NS::set<int> &st) {
+  std::cout << "size: " << st.size() << " |";
+  int  last = 0;
+  bool ordered = true;
+  for (NS::set<int>::iterator it = st.begin(); it != st.end(); ++it) {
+    ordered = ordered && (it == st.begin() || last < *it);
+    last = *it;
+    std::cout << ' ' << *it;
+  }
+  std::cout << (ordered ? "" : " out of order") << std::endl;
+}
+
+int set_erase_range_test ()
+{
+  std::cout << "set erase range test:\n";
+  NS::set<int> st;
+  for (int i = 0; i < 20; ++i)
+    st.insert((i * 11) % 20 * 5);
+  st.erase(st.find(25), st.find(25));
+  set_erase_print(st);
+  st.erase(st.find(35), st.find(40));
+  set_erase_print(st);
+  st.erase(st.find(10), st.find(60));
+  set_erase_print(st);
+  st.erase(st.find(80), st.end());
+  set_erase_print(st);
+  st.erase(st.begin(), ++st.begin());
+  set_erase_print(st);
+  st.erase(st.begin(), st.end());
+  set_erase_print(st);
+  st.insert(3);
+  st.insert(1);
+  set_erase_print(st);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <string>
+
+#if defined(USING_STD)
+# define NS std
+# define SMALL_VECTOR(T, N) std::vector<T>
+#include <vector>
+#elif defined(USING_FT)
+# define NS ft
+# define SMALL_VECTOR(T, N) ft::small_vector<T, N>
+#include "small_vector.hpp"
+#endif
+
+#ifdef NS
+
+int small_vector_test(void) {
+    std::cout << "small vector test: \n";
+    SMALL_VECTOR(std::string, 4) v;
+    // stays inline
+    v.push_back("a");
+    v.push_back("b");
+    v.insert(v.begin(), "c");
+    // spills to the heap
+    for (int i = 0; i < 10; i++)
+        v.push_back(std::string(i + 1, 'x'));
+    v.insert(v.begin() + 2, 3, "y");
+    v.erase(v.begin() + 1, v.begin() + 4);
+    v.erase(v.begin());
+    std::cout << "size: " << v.size() << std::endl;
+    for (SMALL_VECTOR(std::string, 4)::iterator it = v.begin(); it != v.end(); it++)
+        std::cout << *it << ' ';
+    std::cout << '\n';
+
+    SMALL_VECTOR(std::string, 4) v2(3, "z");
+    v2.swap(v);
+    std::cout << v.size() << ' ' << v2.size() << ' ' << (v < v2) << ' ' << (v == v) << std::endl;
+    v2.resize(2);
+    v2.pop_back();
+    std::cout << v2.back() << ' ' << *v2.rbegin() << std::endl;
+
+    // two ints mean count and value, not a range
+    SMALL_VECTOR(int, 4) n(5, 7);
+    n.insert(n.begin() + 1, 2, 3);
+    n.insert(n.end(), 6, 1);
+    std::cout << n.size() << ':';
+    for (SMALL_VECTOR(int, 4)::iterator it = n.begin(); it != n.end(); it++)
+        std::cout << ' ' << *it;
+    std::cout << '\n';
+    n.assign(3, 9);
+    std::cout << n.size() << ' ' << n[0] << ' ' << n[2] << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,164 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+#include "common.hpp"
+
+#if defined(USING_STD)
+# define NS std
+# define MAPPED_MAP(K, T) stashed_map<K, T>
+# define MAPPED_SET(T) stashed_set<T>
+#include <map>
+#include <set>
+
+// the standard library has no snapshots: a copy kept aside per path stands
+// in for the file, and damaging the file drops it so opening fails the
+// same way
+static std::map<std::string, std::map<int, int> > map_stash;
+static std::map<std::string, std::set<int> >      set_stash;
+
+template <class K, class T>
+struct stashed_map : public std::map<K, T> {
+    explicit stashed_map(const char *path) {
+        if (!map_stash.count(path))
+            throw std::runtime_error("snapshot: bad header");
+        std::map<K, T>::operator=(map_stash[path]);
+    }
+};
+
+template <class T>
+struct stashed_set : public std::set<T> {
+    explicit stashed_set(const char *path) {
+        std::set<T>::operator=(set_stash[path]);
+    }
+};
+
+static void write_snapshot(const char *path, const std::map<int, int> &m) {
+    map_stash[path] = m;
+}
+
+static void write_snapshot(const char *path, const std::set<int> &s) {
+    set_stash[path] = s;
+}
+
+static void truncate_snapshot(const char *path, size_t) {
+    map_stash.erase(path);
+}
+
+static void corrupt_count(const char *path, uint64_t) {
+    map_stash.erase(path);
+}
+
+static void corrupt_offset(const char *path, uint64_t) {
+    map_stash.erase(path);
+}
+#elif defined(USING_FT)
+# define NS ft
+# define MAPPED_MAP(K, T) ft::mapped_map<K, T>
+# define MAPPED_SET(T) ft::mapped_set<T>
+#include "snapshot.hpp"
+
+using ft::write_snapshot;
+
+static void truncate_snapshot(const char *path, size_t length) {
+    if (truncate(path, length) != 0)
+        throw std::runtime_error("cannot truncate");
+}
+
+static void corrupt_field(const char *path, uint64_t value, size_t offset) {
+    int fd = open(path, O_WRONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open");
+    ssize_t written = pwrite(fd, &value, sizeof(value), offset);
+    close(fd);
+    if (written != sizeof(value))
+        throw std::runtime_error("cannot write");
+}
+
+static void corrupt_count(const char *path, uint64_t count) {
+    corrupt_field(path, count, offsetof(ft::snapshot_header, count));
+}
+
+static void corrupt_offset(const char *path, uint64_t offset) {
+    corrupt_field(path, offset, offsetof(ft::snapshot_header, data_offset));
+}
+#endif
+
+#ifdef NS
+
+static const char *snapshot_path = "/tmp/ft_snapshot_test.bin";
+
+template <class M>
+static void open_snapshot(const char *name) {
+    std::cout << name << ": ";
+    try {
+        M m(snapshot_path);
+        std::cout << "opened, size " << m.size() << std::endl;
+    }
+    catch (std::runtime_error &e) {
+        std::cout << e.what() << std::endl;
+    }
+}
+
+int snapshot_test(void) {
+    std::cout << "snapshot test: \n";
+    NS::map<int, int> m;
+    for (int i = 0; i < 1000; i++)
+        m[(i * 37) % 1000] = i;
+    write_snapshot(snapshot_path, m);
+    {
+        MAPPED_MAP(int, int) mm(snapshot_path);
+        long sum = 0;
+        bool same = mm.size() == m.size();
+        NS::map<int, int>::iterator it = m.begin();
+        for (MAPPED_MAP(int, int)::const_iterator mit = mm.begin(); same && mit != mm.end(); ++mit, ++it) {
+            same = mit->first == it->first && mit->second == it->second;
+            sum += mit->second;
+        }
+        std::cout << "map: size " << mm.size() << ", same " << same << ", sum " << sum << std::endl;
+        std::cout << mm.at(37) << ' ' << mm.count(999) << ' ' << mm.count(1000) << ' '
+                  << (mm.find(-1) == mm.end()) << ' ' << mm.lower_bound(500)->first << ' '
+                  << mm.upper_bound(500)->first << ' ' << mm.rbegin()->first << ' '
+                  << (mm.equal_range(1000).first == mm.end()) << std::endl;
+    }
+
+    NS::set<int> s;
+    for (int i = 0; i < 100; i++)
+        s.insert(i * i % 97);
+    write_snapshot(snapshot_path, s);
+    {
+        MAPPED_SET(int) ms(snapshot_path);
+        std::cout << "set: size " << ms.size() << " |";
+        for (MAPPED_SET(int)::const_iterator it = ms.begin(); it != ms.end(); ++it)
+            std::cout << ' ' << *it;
+        std::cout << std::endl;
+        std::cout << ms.count(4) << ' ' << ms.count(5) << ' ' << *ms.lower_bound(5) << std::endl;
+    }
+
+    NS::map<int, int> empty;
+    write_snapshot(snapshot_path, empty);
+    open_snapshot<MAPPED_MAP(int, int) >("empty map");
+
+    // a file cut short after the header must not be read past its end
+    write_snapshot(snapshot_path, m);
+    truncate_snapshot(snapshot_path, 4096 + 10 * sizeof(NS::pair<const int, int>));
+    open_snapshot<MAPPED_MAP(int, int) >("truncated map");
+
+    // a count large enough to wrap count * record_size back into the file
+    write_snapshot(snapshot_path, m);
+    corrupt_count(snapshot_path, (uint64_t)1 << 61);
+    open_snapshot<MAPPED_MAP(int, int) >("corrupt count");
+    write_snapshot(snapshot_path, m);
+    corrupt_count(snapshot_path, 1001);
+    open_snapshot<MAPPED_MAP(int, int) >("count one past the end");
+
+    // records at an offset that is not the one written would be misaligned
+    write_snapshot(snapshot_path, m);
+    corrupt_offset(snapshot_path, 4096 - 4);
+    open_snapshot<MAPPED_MAP(int, int) >("unaligned offset");
+
+    std::remove(snapshot_path);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <string>
+
+#if defined(USING_STD)
+# define NS std
+#include <map>
+typedef std::map<int, std::string> split_map_type;
+#elif defined(USING_FT)
+# define NS ft
+#include "split_map.hpp"
+typedef ft::split_map<int, std::string> split_map_type;
+#endif
+
+#ifdef NS
+
+int split_map_test(void) {
+    std::cout << "split map test: \n";
+    split_map_type m;
+    for (int i = 0; i < 3000; i++)
+        m[(i * 37) % 3001] = std::string(i % 23, 'a' + i % 26);
+    for (int i = 0; i < 3000; i += 4)
+        m.erase((i * 37) % 3001);
+    m.erase(m.lower_bound(100), m.upper_bound(200));
+    m.insert(NS::make_pair(150, std::string("inserted")));
+    m[151] += "appended";
+
+    split_map_type copy(m);
+    copy.erase(copy.begin());
+    m.swap(copy);
+
+    size_t sum = 0;
+    for (split_map_type::iterator it = m.begin(); it != m.end(); ++it)
+        sum += it->first * (*it).second.size();
+    std::cout << "size: " << m.size() << ' ' << copy.size() << " sum: " << sum << std::endl;
+    std::cout << m.find(150)->second << ' ' << m.at(151) << ' ' << m.count(101) << ' ' << m.count(201) << std::endl;
+    std::cout << m.rbegin()->first << ' ' << m.lower_bound(100)->first << ' ' << m.upper_bound(151)->first << std::endl;
+    return 0;
+}
+
+#endif
@@ -5,10 +5,36 @@ int test_iterator(void);
 int test_type_traits(void);
 int lexicographical_compare_test(void);
 int equal_test(void);
+int bulk_compare_test(void);
 int pair_test(void);
 int vector_test(void);
+int vector_bool_test(void);
+int vector_growth_test(void);
+int vector_mmap_test(void);
 int stack_test(void);
+int circular_buffer_test(void);
 int map_test(void);
+int map_find_many_test(void);
+int map_compact_test(void);
+int map_erase_if_test(void);
+int map_bulk_insert_test(void);
+int map_bounds_test(void);
+int map_erase_range_test(void);
 int set_test(void);
+int set_algebra_test(void);
+int set_node_test(void);
+int set_bounds_test(void);
+int set_erase_range_test(void);
+int small_vector_test(void);
+int serialize_test(void);
+int concurrent_map_test(void);
+int rcu_map_test(void);
+int concurrent_stack_test(void);
+int mpmc_queue_test(void);
+int snapshot_test(void);
+int persistent_map_test(void);
+int interval_map_test(void);
+int split_map_test(void);
+int execution_test(void);
 
 #endif
\ No newline at end of file
@@ -1,17 +1,33 @@
 #include <iostream>
-
-#include <iostream>
+#include <sstream>
+#include <iterator>
 
 #if defined(USING_STD)
 # define NS std
+# define ERASE_IF(c, pred, n) \
+    n = c.end() - std::remove_if(c.begin(), c.end(), pred); c.erase(c.end() - n, c.end())
+# define GROWN_VECTOR(T, Policy) std::vector<T>
+# define MALLOC_VECTOR(T) std::vector<T>
+# define MMAP_VECTOR(T) std::vector<T>
 #include <vector>
+#include <algorithm>
 #elif defined(USING_FT)
 # define NS ft
+# define ERASE_IF(c, pred, n) n = NS::erase_if(c, pred)
+# define GROWN_VECTOR(T, Policy) ft::vector<T, std::allocator<T>, Policy>
+# define MALLOC_VECTOR(T) ft::vector<T, ft::malloc_allocator<T> >
+# define MMAP_VECTOR(T) ft::vector<T, ft::mmap_allocator<T, 4096> >
 #include "vector.hpp"
+#include "mmap_allocator.hpp"
 #endif
+#include "growth_policy.hpp"
 
 #ifdef NS
 
+static bool is_odd(int x) {
+    return x % 2 != 0;
+}
+
 int vector_test(void) {
     std::cout << "vector test: \n";
     int numbers[]={10,20,30,40,50};
@@ -62,7 +78,142 @@ int vector_test(void) {
     for (NS::vector<int>::iterator it=v.begin(); it!=v.end(); it++)
         std::cout << *it << ' ';
     std::cout << '\n';
+    // ranges read once: from a stream, inserted in the middle
+    std::istringstream in("1 2 3 4 5 6 7");
+    v.insert(v.begin() + 2, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    std::cout << v.size() << ' ' << v[1] << ' ' << v[2] << ' ' << v[8] << ' ' << v[9] << '\n';
+    std::istringstream again("8 9");
+    NS::vector<int> v3((std::istream_iterator<int>(again)), std::istream_iterator<int>());
+    v.assign(v3.begin(), v3.end());
+    v.insert(v.end(), 2, 7);
+    for (NS::vector<int>::iterator it=v.begin(); it!=v.end(); it++)
+        std::cout << *it << ' ';
+    std::cout << '\n';
+    // erase_if
+    for (int i = 0; i < 10; i++)
+        v.push_back(i * 3);
+    size_t erased = 0;
+    ERASE_IF(v, is_odd, erased);
+    std::cout << erased << ':';
+    for (NS::vector<int>::iterator it=v.begin(); it!=v.end(); it++)
+        std::cout << ' ' << *it;
+    std::cout << '\n';
+    return 0;
+}
+
+int vector_bool_test(void) {
+    std::cout << "vector<bool> test: \n";
+    NS::vector<bool> v(1000, false);
+    for (size_t i = 0; i < v.size(); i += 7)
+        v[i] = true;
+    v.insert(v.begin() + 3, 130, true);
+    v.erase(v.begin() + 500, v.begin() + 700);
+    v.resize(1100, true);
+    v.push_back(false);
+    v[5].flip();
+
+    NS::vector<bool> w(v.begin() + 10, v.end() - 10);
+    w.flip();
+    std::cout << v.size() << ' ' << NS::count(v.begin(), v.end(), true) << ' '
+              << NS::count(w.begin(), w.end(), false) << std::endl;
+    std::cout << NS::find(v.begin() + 200, v.end(), true) - v.begin() << ' '
+              << NS::find(w.begin(), w.end(), true) - w.begin() << std::endl;
+
+    NS::vector<bool> x(v);
+    std::cout << (x == v) << (x < v) << std::endl;
+    x[900] = !x[900];
+    std::cout << (x == v) << (x < v) << (v < x) << std::endl;
+    x.assign(64, true);
+    v.assign(x.begin(), x.end());
+    v.pop_back();
+    std::cout << (v < x) << (x < v) << ' ' << v.size() << std::endl;
+    for (NS::vector<bool>::reverse_iterator it = w.rbegin(); it != w.rbegin() + 20; ++it)
+        std::cout << *it;
+    std::cout << std::endl;
+    return 0;
+}
+
+// the capacities a vector goes through while 600 ints are pushed, the
+// std build works them out from the policy itself
+template <class Policy>
+static void print_growth(const char *name) {
+    std::cout << name << ':';
+#ifdef USING_STD
+    size_t capacity = 0;
+    for (size_t n = 1; n <= 600; n++) {
+        if (n > capacity) {
+            capacity = Policy::next(capacity, n, sizeof(int));
+            std::cout << ' ' << capacity;
+        }
+    }
+#else
+    GROWN_VECTOR(int, Policy) v;
+    size_t capacity = v.capacity();
+    for (int n = 1; n <= 600; n++) {
+        v.push_back(n);
+        if (v.capacity() != capacity) {
+            capacity = v.capacity();
+            std::cout << ' ' << capacity;
+        }
+    }
+#endif
+    std::cout << '\n';
+}
+
+int vector_growth_test(void) {
+    std::cout << "vector growth test: \n";
+    print_growth<ft::grow_double>("double");
+    print_growth<ft::grow_by_half>("by half");
+    print_growth<ft::grow_page_rounded<> >("page rounded");
+    print_growth<ft::grow_size_class>("size class");
+
+    // grown and shrunk through realloc
+    MALLOC_VECTOR(int) v;
+    for (int i = 0; i < 5000; i++)
+        v.push_back(i * 3);
+    v.erase(v.begin() + 10, v.end() - 10);
+    v.shrink_to_fit();
+    std::cout << v.size() << ' ' << (v.capacity() == v.size()) << ':';
+    for (size_t i = 0; i < v.size(); i++)
+        std::cout << ' ' << v[i];
+    std::cout << '\n';
+    v.insert(v.begin() + 5, 3000, 7);
+    long sum = 0;
+    for (size_t i = 0; i < v.size(); i++)
+        sum += v[i] * (long)(i + 1);
+    std::cout << v.size() << ' ' << sum << std::endl;
+    v.clear();
+    v.shrink_to_fit();
+    std::cout << v.size() << ' ' << v.capacity() << std::endl;
     return 0;
 }
 
-#endif
\ No newline at end of file
+int vector_mmap_test(void) {
+    std::cout << "vector mmap test: \n";
+    // mapped past 4 KiB, grown with mremap, then back to malloc
+    MMAP_VECTOR(int) v;
+    for (int i = 0; i < 100000; i++)
+        v.push_back(i);
+    long sum = 0;
+    for (size_t i = 0; i < v.size(); i++)
+        sum += v[i];
+    std::cout << v.size() << ' ' << sum << std::endl;
+    v.erase(v.begin() + 100, v.end());
+    v.shrink_to_fit();
+    v.push_back(-1);
+    sum = 0;
+    for (size_t i = 0; i < v.size(); i++)
+        sum += v[i];
+    std::cout << v.size() << ' ' << sum << ' ' << v.back() << std::endl;
+
+    MMAP_VECTOR(int)::allocator_type alloc;
+    try {
+        alloc.allocate(alloc.max_size() + 1);
+        std::cout << "allocated" << std::endl;
+    } catch (std::bad_alloc &) {
+        std::cout << "bad_alloc" << std::endl;
+    }
+    return 0;
+}
+
+#endif
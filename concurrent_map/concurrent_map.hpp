@@ -0,0 +1,219 @@
+#ifndef _CONCURRENT_MAP_HPP_INCLUDED_
+#define _CONCURRENT_MAP_HPP_INCLUDED_
+#include "common.hpp"
+#include <pthread.h>
+#include "functional.hpp"
+#include "utility.hpp"
+#include "map.hpp"
+
+namespace ft {
+    // ordered map split into independently locked shards: a key lives in
+    // shard hash(key) % shard_count(), every shard is an ft::map behind its
+    // own reader-writer lock, so threads touching different shards never
+    // wait for each other and readers of the same shard share the lock.
+    // Point operations lock a single shard, for_each locks all of them for
+    // reading and merges the shards back into key order.
+    template <class Key, class T, class Compare = less<Key>, class Hash = hash<Key>,
+              class Allocator = std::allocator<pair<const Key, T> > >
+    class concurrent_map {
+        public:
+            typedef Key                                     key_type;
+            typedef T                                       mapped_type;
+            typedef pair<const key_type, mapped_type>       value_type;
+            typedef Compare                                 key_compare;
+            typedef Hash                                    hasher;
+            typedef Allocator                               allocator_type;
+            typedef size_t                                  size_type;
+            typedef map<Key, T, Compare, Allocator>         shard_type;
+
+        private:
+            struct _Shard {
+                char                     padBefore[64]; // keeps locks of neighbour
+                pthread_rwlock_t         lock;          // shards on separate
+                shard_type               map;           // cache lines
+                char                     padAfter[64];
+
+                _Shard() {
+                    pthread_rwlock_init(&lock, NULL);
+                }
+
+                ~_Shard() {
+                    pthread_rwlock_destroy(&lock);
+                }
+            };
+
+            // scoped locks
+            struct _ReadLock {
+                pthread_rwlock_t *lock;
+                explicit _ReadLock(pthread_rwlock_t *pLock) : lock(pLock) {
+                    pthread_rwlock_rdlock(lock);
+                }
+                ~_ReadLock() {
+                    pthread_rwlock_unlock(lock);
+                }
+            };
+
+            struct _WriteLock {
+                pthread_rwlock_t *lock;
+                explicit _WriteLock(pthread_rwlock_t *pLock) : lock(pLock) {
+                    pthread_rwlock_wrlock(lock);
+                }
+                ~_WriteLock() {
+                    pthread_rwlock_unlock(lock);
+                }
+            };
+
+            _Shard    *_shards;
+            size_type _shardCount;
+            Compare   _cmp;
+            Hash      _hash;
+
+            concurrent_map(concurrent_map const &);
+            concurrent_map &operator=(concurrent_map const &);
+
+            _Shard &_shardOf(const key_type &k) const {
+                return _shards[_hash(k) % _shardCount];
+            }
+
+        public:
+            // no comparator argument: the shard maps order their keys with a
+            // default constructed Compare, the merge in for_each must agree
+            explicit concurrent_map(size_type shards = 16, const hasher &hash = hasher())
+                : _shards(NULL), _shardCount(shards ? shards : 1), _cmp(), _hash(hash)
+            {
+                _shards = new _Shard[_shardCount];
+            }
+
+            ~concurrent_map() {
+                delete[] _shards;
+            }
+
+            // capacity, sizes are read shard by shard so they are only exact
+            // while no writer is running
+            size_type shard_count() const {
+                return _shardCount;
+            }
+
+            size_type shard_size(size_type shard) const {
+                _ReadLock lock(&_shards[shard].lock);
+                return _shards[shard].map.size();
+            }
+
+            size_type size() const {
+                size_type total = 0;
+                for (size_type i = 0; i < _shardCount; i++)
+                    total += shard_size(i);
+                return total;
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            // modifiers
+            bool insert(const value_type &val) {
+                _Shard     &shard = _shardOf(val.first);
+                _WriteLock lock(&shard.lock);
+                return shard.map.insert(val).second;
+            }
+
+            // returns true if the key was new
+            bool insert_or_assign(const key_type &k, const mapped_type &obj) {
+                _Shard     &shard = _shardOf(k);
+                _WriteLock lock(&shard.lock);
+                pair<typename shard_type::iterator, bool> ret = shard.map.insert(value_type(k, obj));
+                if (!ret.second)
+                    ret.first->second = obj;
+                return ret.second;
+            }
+
+            // calls f(mapped_type&) under the shard's write lock, the value is
+            // default constructed first if the key is missing
+            template <class Function>
+            void update(const key_type &k, Function f) {
+                _Shard     &shard = _shardOf(k);
+                _WriteLock lock(&shard.lock);
+                f(shard.map[k]);
+            }
+
+            size_type erase(const key_type &k) {
+                _Shard     &shard = _shardOf(k);
+                _WriteLock lock(&shard.lock);
+                return shard.map.erase(k);
+            }
+
+            void clear() {
+                for (size_type i = 0; i < _shardCount; i++) {
+                    _WriteLock lock(&_shards[i].lock);
+                    _shards[i].map.clear();
+                }
+            }
+
+            // lookup, values are copied out while the lock is held
+            bool find(const key_type &k, mapped_type &out) const {
+                _Shard    &shard = _shardOf(k);
+                _ReadLock lock(&shard.lock);
+                typename shard_type::iterator it = shard.map.find(k);
+                if (it == shard.map.end())
+                    return false;
+                out = it->second;
+                return true;
+            }
+
+            size_type count(const key_type &k) const {
+                _Shard    &shard = _shardOf(k);
+                _ReadLock lock(&shard.lock);
+                return shard.map.count(k);
+            }
+
+            // calls f(const value_type&) on every element in key order, all
+            // shards stay read locked for the whole walk
+            template <class Function>
+            Function for_each(Function f) const {
+                typedef typename shard_type::iterator shard_iterator;
+
+                // allocated before any lock is taken, a bad_alloc must not
+                // leave shards locked
+                shard_iterator *heads = new shard_iterator[_shardCount];
+                for (size_type i = 0; i < _shardCount; i++)
+                    pthread_rwlock_rdlock(&_shards[i].lock);
+                for (size_type i = 0; i < _shardCount; i++)
+                    heads[i] = _shards[i].map.begin();
+                try {
+                    while (true) {
+                        size_type best = _shardCount;
+                        for (size_type i = 0; i < _shardCount; i++) {
+                            if (heads[i] == _shards[i].map.end())
+                                continue;
+                            if (best == _shardCount || _cmp(heads[i]->first, heads[best]->first))
+                                best = i;
+                        }
+                        if (best == _shardCount)
+                            break ;
+                        f(*heads[best]);
+                        ++heads[best];
+                    }
+                } catch (...) {
+                    delete[] heads;
+                    for (size_type i = 0; i < _shardCount; i++)
+                        pthread_rwlock_unlock(&_shards[i].lock);
+                    throw;
+                }
+                delete[] heads;
+                for (size_type i = 0; i < _shardCount; i++)
+                    pthread_rwlock_unlock(&_shards[i].lock);
+                return f;
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            hasher hash_function() const {
+                return _hash;
+            }
+    };
+} // namespace ft
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef _CONCURRENT_STACK_HPP_INCLUDED_
+#define _CONCURRENT_STACK_HPP_INCLUDED_
+#include "common.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+    // lock-free LIFO for any number of pushing and popping threads (Treiber
+    // stack). The head is one 64 bit word: a node pointer in the low 48 bits
+    // (all x86-64 and aarch64 user space addresses fit) and a 16 bit version
+    // tag above it that every successful pop or push bumps, so a head that
+    // was popped and pushed back in between is not mistaken for the one a
+    // thread read (ABA). Popped nodes go to a lock-free free list and are
+    // only returned to the allocator by the destructor, which keeps a node
+    // another thread still peeks at readable.
+    template <class T, class Alloc = std::allocator<T> >
+    class concurrent_stack {
+        public:
+            typedef T      value_type;
+            typedef Alloc  allocator_type;
+            typedef size_t size_type;
+
+        private:
+            struct _Node {
+                _Node *next;
+                T     value;
+            };
+
+            typedef typename Alloc::template rebind<_Node>::other node_allocator;
+
+            // plain values no wider than a word are stored atomically, so
+            // top() may read a node that is being refilled
+            typedef integral_constant<bool, is_trivially_copyable<T>::value
+                                            && sizeof(T) <= sizeof(uint64_t)> _WordSized;
+
+            static const uint64_t _ptrMask = (uint64_t(1) << 48) - 1;
+
+            // a tagged list head on its own cache line
+            struct _Head {
+                char     padBefore[64];
+                uint64_t word;
+                char     padAfter[64];
+
+                _Head() : word(0) {}
+            };
+
+            _Head          _top;
+            _Head          _free;
+            Alloc          _alloc;
+            node_allocator _nodeAlloc;
+
+            concurrent_stack(concurrent_stack const &);
+            concurrent_stack &operator=(concurrent_stack const &);
+
+            static _Node *_ptr(uint64_t word) {
+                return reinterpret_cast<_Node*>(static_cast<uintptr_t>(word & _ptrMask));
+            }
+
+            static uint64_t _next(uint64_t word, _Node *node) {
+                return ((word >> 48) + 1) << 48 | static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node));
+            }
+
+            static void _push(_Head &head, _Node *node) {
+                uint64_t old = __atomic_load_n(&head.word, __ATOMIC_RELAXED);
+                do {
+                    __atomic_store_n(&node->next, _ptr(old), __ATOMIC_RELAXED);
+                } while (!__atomic_compare_exchange_n(&head.word, &old, _next(old, node), true,
+                                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+            }
+
+            // the node may be recycled by another thread while we read its
+            // next pointer, the tag makes the exchange fail in that case
+            static _Node *_pop(_Head &head) {
+                uint64_t old = __atomic_load_n(&head.word, __ATOMIC_ACQUIRE);
+                while (_ptr(old)) {
+                    _Node *next = __atomic_load_n(&_ptr(old)->next, __ATOMIC_RELAXED);
+                    if (__atomic_compare_exchange_n(&head.word, &old, _next(old, next), true,
+                                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+                        return _ptr(old);
+                }
+                return NULL;
+            }
+
+            _Node *_getNode() {
+                _Node *node = _pop(_free);
+                return node ? node : _nodeAlloc.allocate(1);
+            }
+
+            void _store(_Node *node, const value_type &val, true_type) {
+                value_type value = val;
+                __atomic_store(&node->value, &value, __ATOMIC_RELAXED);
+            }
+
+            void _store(_Node *node, const value_type &val, false_type) {
+                _alloc.construct(&node->value, val);
+            }
+
+        public:
+            explicit concurrent_stack(const allocator_type &alloc = allocator_type())
+                : _alloc(alloc), _nodeAlloc(alloc) {}
+
+            // no other thread may still use the stack
+            ~concurrent_stack() {
+                for (_Node *node = _ptr(_top.word); node; ) {
+                    _Node *next = node->next;
+                    _alloc.destroy(&node->value);
+                    _nodeAlloc.deallocate(node, 1);
+                    node = next;
+                }
+                for (_Node *node = _ptr(_free.word); node; ) {
+                    _Node *next = node->next;
+                    _nodeAlloc.deallocate(node, 1);
+                    node = next;
+                }
+            }
+
+            // only a hint while other threads push or pop
+            bool empty() const {
+                return _ptr(__atomic_load_n(&_top.word, __ATOMIC_RELAXED)) == NULL;
+            }
+
+            void push(const value_type &val) {
+                _Node *node = _getNode();
+                try {
+                    _store(node, val, _WordSized());
+                } catch (...) {
+                    _push(_free, node);
+                    throw;
+                }
+                _push(_top, node);
+            }
+
+            // copies the top element into out and removes it, false if the
+            // stack was empty. If T's copy assignment throws, the element
+            // goes back on top
+            bool pop(value_type &out) {
+                _Node *node = _pop(_top);
+                if (!node)
+                    return false;
+                try {
+                    out = node->value;
+                } catch (...) {
+                    _push(_top, node);
+                    throw;
+                }
+                _alloc.destroy(&node->value);
+                _push(_free, node);
+                return true;
+            }
+
+            // copies the top element into out without removing it. The copy
+            // is read from a node another thread may be popping and refilling
+            // at the same time and thrown away if the head moved meanwhile,
+            // so it is only offered for the plain word sized types push
+            // stores atomically
+            bool top(value_type &out) const {
+                typedef char only_for_word_sized_plain_types[_WordSized::value ? 1 : -1];
+                (void)sizeof(only_for_word_sized_plain_types);
+
+                uint64_t word = __atomic_load_n(&_top.word, __ATOMIC_ACQUIRE);
+                while (_ptr(word)) {
+                    value_type value;
+                    __atomic_load(&_ptr(word)->value, &value, __ATOMIC_RELAXED);
+                    uint64_t   again = __atomic_load_n(&_top.word, __ATOMIC_ACQUIRE);
+                    if (again == word) {
+                        out = value;
+                        return true;
+                    }
+                    word = again;
+                }
+                return false;
+            }
+    };
+} // namespace ft
+
+#endif
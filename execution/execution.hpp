@@ -0,0 +1,661 @@
+#ifndef _EXECUTION_HPP_INCLUDED_
+#define _EXECUTION_HPP_INCLUDED_
+#include "common.hpp"
+#include "type_traits.hpp"
+#include "iterator_traits.hpp"
+#include "algorithm.hpp"
+#include "vector.hpp"
+#include "thread_pool.hpp"
+
+// Execution policy overloads of for_each, transform, reduce, sort, find,
+// count_if, copy and fill:
+//   seq        plain loops, what the overloads without a policy do
+//   unseq      index loops the compiler may vectorize
+//   par        chunks run on thread_pool::global(), or on the pool given
+//              with par.on(pool)
+//   par_unseq  both
+// Parallelism and vectorization need random access iterators (ft::vector's
+// iterators, raw pointers), other ranges run sequentially whatever the
+// policy says. As with the standard policies, an exception escaping a user
+// function under a policy calls std::terminate.
+
+namespace ft {
+    namespace execution {
+        struct sequenced_policy {};
+        struct unsequenced_policy {};
+
+        // the pool is NULL for the global one
+        struct parallel_policy {
+            thread_pool *pool;
+
+            parallel_policy() : pool(NULL) {}
+            explicit parallel_policy(thread_pool &pPool) : pool(&pPool) {}
+
+            parallel_policy on(thread_pool &pPool) const {
+                return parallel_policy(pPool);
+            }
+        };
+
+        struct parallel_unsequenced_policy {
+            thread_pool *pool;
+
+            parallel_unsequenced_policy() : pool(NULL) {}
+            explicit parallel_unsequenced_policy(thread_pool &pPool) : pool(&pPool) {}
+
+            parallel_unsequenced_policy on(thread_pool &pPool) const {
+                return parallel_unsequenced_policy(pPool);
+            }
+        };
+
+        static const sequenced_policy            seq = sequenced_policy();
+        static const unsequenced_policy          unseq = unsequenced_policy();
+        static const parallel_policy             par = parallel_policy();
+        static const parallel_unsequenced_policy par_unseq = parallel_unsequenced_policy();
+    } // namespace execution
+
+    template <class T>
+    struct is_execution_policy : public false_type {};
+
+    template <>
+    struct is_execution_policy<execution::sequenced_policy> : public true_type {};
+
+    template <>
+    struct is_execution_policy<execution::unsequenced_policy> : public true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_policy> : public true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : public true_type {};
+
+    namespace detail {
+        // elements below which a range is not worth splitting
+        static const size_t parallel_grain = 1 << 14;
+
+        // calls f(i) for every i in [0, tasks) and returns once all calls
+        // returned, stealing spreads the calls over the pool's workers
+        template <class Function>
+        void parallel_run(thread_pool *pool, size_t tasks, Function &f) {
+            if (tasks <= 1) {
+                for (size_t i = 0; i < tasks; i++)
+                    f(i);
+                return ;
+            }
+            pool->for_each_index(0, tasks, f, 1);
+        }
+
+        inline size_t chunk_count(thread_pool *pool, size_t n) {
+            size_t most = pool->concurrency() * 4;
+            size_t chunks = n / parallel_grain;
+            return chunks < 1 ? 1 : (chunks > most ? most : chunks);
+        }
+
+        inline size_t chunk_begin(size_t n, size_t chunks, size_t i) {
+            return n / chunks * i + (i < n % chunks ? i : n % chunks);
+        }
+
+        // what a policy allows on a given pair of iterators, and the pool
+        // a parallel one runs on
+        struct seq_tag {
+            explicit seq_tag(thread_pool *) {}
+        };
+
+        template <bool Parallel, bool Unsequenced>
+        struct random_access_tag {
+            thread_pool *pool;
+
+            explicit random_access_tag(thread_pool *pPool) : pool(Parallel && !pPool ? &thread_pool::global() : pPool) {}
+        };
+
+        template <class Policy>
+        thread_pool *policy_pool(const Policy &) {
+            return NULL;
+        }
+
+        inline thread_pool *policy_pool(const execution::parallel_policy &policy) {
+            return policy.pool;
+        }
+
+        inline thread_pool *policy_pool(const execution::parallel_unsequenced_policy &policy) {
+            return policy.pool;
+        }
+
+        template <class Policy>
+        struct policy_traits {
+            static const bool parallel = false;
+            static const bool unsequenced = false;
+        };
+
+        template <>
+        struct policy_traits<execution::unsequenced_policy> {
+            static const bool parallel = false;
+            static const bool unsequenced = true;
+        };
+
+        template <>
+        struct policy_traits<execution::parallel_policy> {
+            static const bool parallel = true;
+            static const bool unsequenced = false;
+        };
+
+        template <>
+        struct policy_traits<execution::parallel_unsequenced_policy> {
+            static const bool parallel = true;
+            static const bool unsequenced = true;
+        };
+
+        template <class Policy, class Iterator1, class Iterator2 = Iterator1,
+                  bool RandomAccess = is_same<typename iterator_traits<Iterator1>::iterator_category,
+                                              random_access_iterator_tag>::value
+                                   && is_same<typename iterator_traits<Iterator2>::iterator_category,
+                                              random_access_iterator_tag>::value,
+                  bool Plain = !policy_traits<Policy>::parallel && !policy_traits<Policy>::unsequenced>
+        struct execution_mode {
+            typedef random_access_tag<policy_traits<Policy>::parallel, policy_traits<Policy>::unsequenced> type;
+        };
+
+        template <class Policy, class Iterator1, class Iterator2, bool Plain>
+        struct execution_mode<Policy, Iterator1, Iterator2, false, Plain> {
+            typedef seq_tag type;
+        };
+
+        template <class Policy, class Iterator1, class Iterator2>
+        struct execution_mode<Policy, Iterator1, Iterator2, true, true> {
+            typedef seq_tag type;
+        };
+
+        // for_each
+        template <class RandomAccessIterator, class Function, bool Unsequenced>
+        struct for_each_task {
+            RandomAccessIterator first;
+            size_t               n;
+            size_t               chunks;
+            Function             f;
+
+            for_each_task(RandomAccessIterator pFirst, size_t pN, size_t pChunks, Function pF)
+                : first(pFirst), n(pN), chunks(pChunks), f(pF) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                if (Unsequenced) {
+#pragma GCC ivdep
+                    for (size_t k = begin; k < end; k++)
+                        f(first[k]);
+                }
+                else {
+                    for (size_t k = begin; k < end; k++)
+                        f(first[k]);
+                }
+            }
+        };
+
+        template <class InputIterator, class Function>
+        void for_each(InputIterator first, InputIterator last, Function f, seq_tag) {
+            ft::for_each(first, last, f);
+        }
+
+        template <class RandomAccessIterator, class Function, bool Parallel, bool Unsequenced>
+        void for_each(RandomAccessIterator first, RandomAccessIterator last, Function f,
+                      random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t                                                     n = last - first;
+            for_each_task<RandomAccessIterator, Function, Unsequenced> task(first, n, Parallel ? chunk_count(mode.pool, n) : 1, f);
+            parallel_run(mode.pool, task.chunks, task);
+        }
+
+        // transform
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class UnaryOperation, bool Unsequenced>
+        struct transform_task {
+            RandomAccessIterator1 first;
+            RandomAccessIterator2 result;
+            size_t                n;
+            size_t                chunks;
+            UnaryOperation        op;
+
+            transform_task(RandomAccessIterator1 pFirst, RandomAccessIterator2 pResult, size_t pN,
+                           size_t pChunks, UnaryOperation pOp)
+                : first(pFirst), result(pResult), n(pN), chunks(pChunks), op(pOp) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                if (Unsequenced) {
+#pragma GCC ivdep
+                    for (size_t k = begin; k < end; k++)
+                        result[k] = op(first[k]);
+                }
+                else {
+                    for (size_t k = begin; k < end; k++)
+                        result[k] = op(first[k]);
+                }
+            }
+        };
+
+        template <class InputIterator, class OutputIterator, class UnaryOperation>
+        OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result,
+                                 UnaryOperation op, seq_tag)
+        {
+            return ft::transform(first, last, result, op);
+        }
+
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class UnaryOperation,
+                  bool Parallel, bool Unsequenced>
+        RandomAccessIterator2 transform(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                        RandomAccessIterator2 result, UnaryOperation op,
+                                        random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t n = last - first;
+            transform_task<RandomAccessIterator1, RandomAccessIterator2, UnaryOperation, Unsequenced>
+                task(first, result, n, Parallel ? chunk_count(mode.pool, n) : 1, op);
+            parallel_run(mode.pool, task.chunks, task);
+            return result + n;
+        }
+
+        // reduce: every chunk folds its own elements, the partial results
+        // are then folded into init in chunk order
+        template <class RandomAccessIterator, class T, class BinaryOperation>
+        struct reduce_task {
+            RandomAccessIterator first;
+            size_t               n;
+            size_t               chunks;
+            BinaryOperation      op;
+            vector<T>            *partials;
+
+            reduce_task(RandomAccessIterator pFirst, size_t pN, BinaryOperation pOp, vector<T> *pPartials)
+                : first(pFirst), n(pN), chunks(pPartials->size()), op(pOp), partials(pPartials) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                T      sum = first[begin];
+                for (size_t k = begin + 1; k < end; k++)
+                    sum = op(sum, first[k]);
+                (*partials)[i] = sum;
+            }
+        };
+
+        template <class InputIterator, class T, class BinaryOperation>
+        T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op, seq_tag) {
+            return ft::reduce(first, last, init, op);
+        }
+
+        template <class RandomAccessIterator, class T, class BinaryOperation, bool Parallel, bool Unsequenced>
+        T reduce(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                 random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t n = last - first;
+            if (!Parallel || chunk_count(mode.pool, n) == 1)
+                return ft::reduce(first, last, init, op);
+            vector<T>                                             partials(chunk_count(mode.pool, n), init);
+            reduce_task<RandomAccessIterator, T, BinaryOperation> task(first, n, op, &partials);
+            parallel_run(mode.pool, task.chunks, task);
+            for (size_t i = 0; i < partials.size(); i++)
+                init = op(init, partials[i]);
+            return init;
+        }
+
+        template <class T>
+        struct plus {
+            T operator()(const T &a, const T &b) const {
+                return a + b;
+            }
+        };
+
+        // find: chunks give up as soon as an earlier chunk found a match
+        template <class RandomAccessIterator, class T>
+        struct find_task {
+            RandomAccessIterator first;
+            size_t               n;
+            size_t               chunks;
+            const T              *val;
+            size_t               found;
+
+            find_task(RandomAccessIterator pFirst, size_t pN, size_t pChunks, const T *pVal)
+                : first(pFirst), n(pN), chunks(pChunks), val(pVal), found(pN) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                for (size_t k = begin; k < end; k++) {
+                    if ((k & 1023) == 0 && __atomic_load_n(&found, __ATOMIC_RELAXED) < begin)
+                        return ;
+                    if (first[k] == *val) {
+                        size_t best = __atomic_load_n(&found, __ATOMIC_RELAXED);
+                        while (k < best && !__atomic_compare_exchange_n(&found, &best, k, true,
+                                                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                            ;
+                        return ;
+                    }
+                }
+            }
+        };
+
+        template <class InputIterator, class T>
+        InputIterator find(InputIterator first, InputIterator last, const T &val, seq_tag) {
+            return ft::find(first, last, val);
+        }
+
+        template <class RandomAccessIterator, class T, bool Parallel, bool Unsequenced>
+        RandomAccessIterator find(RandomAccessIterator first, RandomAccessIterator last, const T &val,
+                                  random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t                             n = last - first;
+            find_task<RandomAccessIterator, T> task(first, n, Parallel ? chunk_count(mode.pool, n) : 1, &val);
+            parallel_run(mode.pool, task.chunks, task);
+            return first + task.found;
+        }
+
+        // count_if
+        template <class RandomAccessIterator, class UnaryPredicate, bool Unsequenced>
+        struct count_if_task {
+            RandomAccessIterator first;
+            size_t               n;
+            size_t               chunks;
+            UnaryPredicate       pred;
+            vector<size_t>       *counts;
+
+            count_if_task(RandomAccessIterator pFirst, size_t pN, UnaryPredicate pPred, vector<size_t> *pCounts)
+                : first(pFirst), n(pN), chunks(pCounts->size()), pred(pPred), counts(pCounts) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                size_t count = 0;
+                if (Unsequenced) {
+#pragma GCC ivdep
+                    for (size_t k = begin; k < end; k++)
+                        count += pred(first[k]) ? 1 : 0;
+                }
+                else {
+                    for (size_t k = begin; k < end; k++)
+                        count += pred(first[k]) ? 1 : 0;
+                }
+                (*counts)[i] = count;
+            }
+        };
+
+        template <class InputIterator, class UnaryPredicate>
+        typename iterator_traits<InputIterator>::difference_type
+        count_if(InputIterator first, InputIterator last, UnaryPredicate pred, seq_tag) {
+            return ft::count_if(first, last, pred);
+        }
+
+        template <class RandomAccessIterator, class UnaryPredicate, bool Parallel, bool Unsequenced>
+        typename iterator_traits<RandomAccessIterator>::difference_type
+        count_if(RandomAccessIterator first, RandomAccessIterator last, UnaryPredicate pred,
+                 random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t                                                           n = last - first;
+            vector<size_t>                                                   counts(Parallel ? chunk_count(mode.pool, n) : 1, 0);
+            count_if_task<RandomAccessIterator, UnaryPredicate, Unsequenced> task(first, n, pred, &counts);
+            parallel_run(mode.pool, task.chunks, task);
+            return ft::reduce(counts.begin(), counts.end(), size_t(0));
+        }
+
+        // fill
+        template <class RandomAccessIterator, class T, bool Unsequenced>
+        struct fill_task {
+            RandomAccessIterator first;
+            size_t               n;
+            size_t               chunks;
+            const T              *val;
+
+            fill_task(RandomAccessIterator pFirst, size_t pN, size_t pChunks, const T *pVal)
+                : first(pFirst), n(pN), chunks(pChunks), val(pVal) {}
+
+            void operator()(size_t i) {
+                size_t begin = chunk_begin(n, chunks, i);
+                size_t end = chunk_begin(n, chunks, i + 1);
+                if (Unsequenced) {
+#pragma GCC ivdep
+                    for (size_t k = begin; k < end; k++)
+                        first[k] = *val;
+                }
+                else {
+                    for (size_t k = begin; k < end; k++)
+                        first[k] = *val;
+                }
+            }
+        };
+
+        template <class ForwardIterator, class T>
+        void fill(ForwardIterator first, ForwardIterator last, const T &val, seq_tag) {
+            ft::fill(first, last, val);
+        }
+
+        template <class RandomAccessIterator, class T, bool Parallel, bool Unsequenced>
+        void fill(RandomAccessIterator first, RandomAccessIterator last, const T &val,
+                  random_access_tag<Parallel, Unsequenced> mode)
+        {
+            size_t                                          n = last - first;
+            fill_task<RandomAccessIterator, T, Unsequenced> task(first, n, Parallel ? chunk_count(mode.pool, n) : 1, &val);
+            parallel_run(mode.pool, task.chunks, task);
+        }
+
+        // identity, copy is a transform
+        template <class T>
+        struct identity {
+            const T &operator()(const T &x) const {
+                return x;
+            }
+        };
+
+        // sort: parallel merge sort. The range is cut into runs sorted in
+        // parallel, then pairs of runs are merged back and forth between the
+        // range and a buffer. Each merge is itself split along its merge
+        // path so every round keeps all threads busy.
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+        size_t merge_path(RandomAccessIterator1 a, size_t na, RandomAccessIterator2 b, size_t nb,
+                          size_t diagonal, Compare comp)
+        {
+            size_t lo = diagonal > nb ? diagonal - nb : 0;
+            size_t hi = diagonal < na ? diagonal : na;
+            while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                if (comp(b[diagonal - mid - 1], a[mid]))
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+        void merge(RandomAccessIterator1 a, size_t na, RandomAccessIterator1 b, size_t nb,
+                   RandomAccessIterator2 out, Compare comp)
+        {
+            size_t i = 0;
+            size_t j = 0;
+            while (i < na && j < nb) {
+                if (comp(b[j], a[i]))
+                    *out++ = b[j++];
+                else
+                    *out++ = a[i++];
+            }
+            for (; i < na; i++)
+                *out++ = a[i];
+            for (; j < nb; j++)
+                *out++ = b[j];
+        }
+
+        template <class RandomAccessIterator, class Compare>
+        struct sort_runs_task {
+            RandomAccessIterator first;
+            const size_t         *bounds;
+            Compare              comp;
+
+            sort_runs_task(RandomAccessIterator pFirst, const size_t *pBounds, Compare pComp)
+                : first(pFirst), bounds(pBounds), comp(pComp) {}
+
+            void operator()(size_t i) {
+                ft::sort(first + bounds[i], first + bounds[i + 1], comp);
+            }
+        };
+
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+        struct merge_round_task {
+            RandomAccessIterator1 src;
+            RandomAccessIterator2 dst;
+            const size_t          *bounds; // run i is [bounds[i], bounds[i + 1])
+            size_t                runs;
+            size_t                pieces;  // per pair of runs
+            Compare               comp;
+
+            merge_round_task(RandomAccessIterator1 pSrc, RandomAccessIterator2 pDst, const size_t *pBounds,
+                             size_t pRuns, size_t pPieces, Compare pComp)
+                : src(pSrc), dst(pDst), bounds(pBounds), runs(pRuns), pieces(pPieces), comp(pComp) {}
+
+            void operator()(size_t t) {
+                size_t pair = t / pieces;
+                size_t piece = t % pieces;
+                size_t start = bounds[2 * pair];
+                size_t middle = bounds[2 * pair + 1];
+                size_t stop = 2 * pair + 2 <= runs ? bounds[2 * pair + 2] : middle;
+                size_t na = middle - start;
+                size_t nb = stop - middle;
+                size_t d0 = chunk_begin(na + nb, pieces, piece);
+                size_t d1 = chunk_begin(na + nb, pieces, piece + 1);
+                size_t i0 = merge_path(src + start, na, src + middle, nb, d0, comp);
+                size_t i1 = merge_path(src + start, na, src + middle, nb, d1, comp);
+                merge(src + start + i0, i1 - i0, src + middle + (d0 - i0), (d1 - i1) - (d0 - i0),
+                      dst + start + d0, comp);
+            }
+        };
+
+        template <class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+        void merge_round(thread_pool *pool, RandomAccessIterator1 src, RandomAccessIterator2 dst,
+                         vector<size_t> &bounds, Compare comp)
+        {
+            size_t runs = bounds.size() - 1;
+            size_t pairs = (runs + 1) / 2;
+            size_t threads = pool->concurrency() * 2;
+            merge_round_task<RandomAccessIterator1, RandomAccessIterator2, Compare>
+                task(src, dst, &bounds[0], runs, threads > pairs ? threads / pairs : 1, comp);
+            parallel_run(pool, pairs * task.pieces, task);
+
+            vector<size_t> merged;
+            for (size_t i = 0; i < bounds.size(); i += 2)
+                merged.push_back(bounds[i]);
+            if (merged.back() != bounds.back())
+                merged.push_back(bounds.back());
+            bounds.swap(merged);
+        }
+
+        template <class RandomAccessIterator, class Compare>
+        void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp, seq_tag) {
+            ft::sort(first, last, comp);
+        }
+
+        template <class RandomAccessIterator, class Compare, bool Parallel, bool Unsequenced>
+        void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+                  random_access_tag<Parallel, Unsequenced> mode)
+        {
+            typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+
+            size_t n = last - first;
+            if (!Parallel || mode.pool->concurrency() == 1 || n < 2 * parallel_grain) {
+                ft::sort(first, last, comp);
+                return ;
+            }
+            size_t runs = mode.pool->concurrency();
+            if (runs > n / parallel_grain)
+                runs = n / parallel_grain;
+
+            vector<size_t> bounds;
+            for (size_t i = 0; i <= runs; i++)
+                bounds.push_back(chunk_begin(n, runs, i));
+            sort_runs_task<RandomAccessIterator, Compare> sorter(first, &bounds[0], comp);
+            parallel_run(mode.pool, runs, sorter);
+
+            vector<value_type> buffer(first, last);
+            bool               inBuffer = false;
+            while (bounds.size() > 2) {
+                if (inBuffer)
+                    merge_round(mode.pool, &buffer[0], first, bounds, comp);
+                else
+                    merge_round(mode.pool, first, &buffer[0], bounds, comp);
+                inBuffer = !inBuffer;
+            }
+            if (inBuffer)
+                detail::transform(&buffer[0], &buffer[0] + n, first, identity<value_type>(),
+                                  random_access_tag<true, true>(mode.pool));
+        }
+    } // namespace detail
+
+    template <class ExecutionPolicy, class ForwardIterator, class Function>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    for_each(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, Function f) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator>::type mode;
+        detail::for_each(first, last, f, mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class UnaryOperation>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value, ForwardIterator2>::type
+    transform(const ExecutionPolicy &policy, ForwardIterator1 first, ForwardIterator1 last,
+              ForwardIterator2 result, UnaryOperation op)
+    {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator1, ForwardIterator2>::type mode;
+        return detail::transform(first, last, result, op, mode(detail::policy_pool(policy)));
+    }
+
+    // op must be associative and commutative, chunks are folded in parallel
+    template <class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value, T>::type
+    reduce(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation op) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator>::type mode;
+        return detail::reduce(first, last, init, op, mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value, T>::type
+    reduce(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, T init) {
+        return ft::reduce(policy, first, last, init, detail::plus<T>());
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    sort(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename detail::execution_mode<ExecutionPolicy, RandomAccessIterator>::type mode;
+        detail::sort(first, last, comp, mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    sort(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last) {
+        ft::sort(policy, first, last, detail::less_than<typename iterator_traits<RandomAccessIterator>::value_type>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value, ForwardIterator>::type
+    find(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, const T &val) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator>::type mode;
+        return detail::find(first, last, val, mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class UnaryPredicate>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value,
+                       typename iterator_traits<ForwardIterator>::difference_type>::type
+    count_if(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, UnaryPredicate pred) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator>::type mode;
+        return detail::count_if(first, last, pred, mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value, ForwardIterator2>::type
+    copy(const ExecutionPolicy &policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator1, ForwardIterator2>::type mode;
+        typedef typename iterator_traits<ForwardIterator1>::value_type value_type;
+        return detail::transform(first, last, result, detail::identity<value_type>(),
+                                 mode(detail::policy_pool(policy)));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    typename enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    fill(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, const T &val) {
+        typedef typename detail::execution_mode<ExecutionPolicy, ForwardIterator>::type mode;
+        detail::fill(first, last, val, mode(detail::policy_pool(policy)));
+    }
+} // namespace ft
+
+#endif
@@ -1,5 +1,8 @@
 #ifndef _FUNCTIONAL_HPP_INCLUDED_
 #define _FUNCTIONAL_HPP_INCLUDED_
+#include "common.hpp"
+#include "type_traits.hpp"
+#include <string>
 
 namespace ft {
     template <class T>
@@ -8,6 +11,51 @@ namespace ft {
             return lhs < rhs;
         }
     };
+
+    // hash for integral keys: the splitmix64 finalizer, so consecutive keys
+    // end up far apart
+    template <class T>
+    struct hash {
+        size_t operator()(const T &val) const {
+            uint64_t x = static_cast<uint64_t>(val);
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return static_cast<size_t>(x ^ (x >> 31));
+        }
+    };
+
+    // FNV-1a
+    template <>
+    struct hash<std::string> {
+        size_t operator()(const std::string &val) const {
+            uint64_t x = 0xcbf29ce484222325ULL;
+            for (size_t i = 0; i < val.size(); i++) {
+                x ^= static_cast<unsigned char>(val[i]);
+                x *= 0x100000001b3ULL;
+            }
+            return static_cast<size_t>(x);
+        }
+    };
+
+    namespace detail {
+        // an unsigned integer that orders keys the way Compare does, so a
+        // batch of them may be radix sorted. Only integral keys under less
+        // have one: the sign bit is flipped so negative keys come first
+        template <class Key, class Compare>
+        struct radix_key {
+            static const bool enabled = false;
+        };
+
+        template <class Key>
+        struct radix_key<Key, less<Key> > {
+            static const bool enabled = is_integral<Key>::value;
+
+            uint64_t operator()(const Key &key) const {
+                uint64_t signBit = Key(-1) < Key(0) ? uint64_t(1) << 63 : 0;
+                return static_cast<uint64_t>(key) ^ signBit;
+            }
+        };
+    } // namespace detail
 } // namespace ft
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,411 @@
+#ifndef _INTERVAL_MAP_HPP_INCLUDED_
+#define _INTERVAL_MAP_HPP_INCLUDED_
+#include "common.hpp"
+#include "functional.hpp"
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include "RBT_Iterator.hpp"
+
+namespace ft {
+    // the half-open interval [low, high)
+    template <class Key>
+    struct interval {
+        Key low;
+        Key high;
+
+        interval() : low(), high() {}
+
+        interval(Key const &pLow, Key const &pHigh) : low(pLow), high(pHigh) {}
+    };
+
+    namespace detail {
+        // every node knows the largest high end in its subtree
+        template <class Key, class Compare>
+        struct interval_augment {
+            struct node_data {
+                Key maxHigh;
+            };
+
+            template <class Node>
+            static void update(Node *pNode) {
+                Compare   cmp;
+                Key const *maxHigh = &pNode->value.first.high;
+                if (!pNode->left->isNull && cmp(*maxHigh, pNode->left->maxHigh))
+                    maxHigh = &pNode->left->maxHigh;
+                if (!pNode->right->isNull && cmp(*maxHigh, pNode->right->maxHigh))
+                    maxHigh = &pNode->right->maxHigh;
+                pNode->maxHigh = *maxHigh;
+            }
+        };
+    } // namespace detail
+
+    // map from intervals to values, ordered by low then high end, which
+    // also finds every interval overlapping a range or holding a point.
+    // It is a RedBlackTree whose nodes carry the largest high end of their
+    // subtree: a subtree ending before the query is skipped, and so is
+    // everything after a node starting past it. The first overlap costs
+    // O(log n). overlapping, containing and the count_* functions find all
+    // of them in a single pruned walk that enters each subtree at most once;
+    // stepping with next_* climbs back up from every match instead, O(log n)
+    // per step at worst and much less when the overlaps are close together
+    template<class Key, class T, class Compare = less<Key>,
+          class Allocator = std::allocator<pair<const interval<Key>, T> > >
+    class interval_map {
+        private:
+            class Comp {
+                private:
+                    Compare _cmp;
+                public:
+                    Comp() : _cmp(Compare()) {}
+                    bool operator()(const pair<const interval<Key>, T> &lhs, const pair<const interval<Key>, T> &rhs) const {
+                        if (_cmp(lhs.first.low, rhs.first.low))
+                            return true;
+                        if (_cmp(rhs.first.low, lhs.first.low))
+                            return false;
+                        return _cmp(lhs.first.high, rhs.first.high);
+                    }
+            };
+
+            typedef detail::interval_augment<Key, Compare>                 augment;
+            typedef RedBlackTree<pair<const interval<Key>, T>, Comp, augment> tree_type;
+            typedef typename tree_type::Node                               tree_node;
+
+            // an interval to overlap, or a point to stab
+            struct _Query {
+                Key  low;
+                Key  high;
+                bool point;
+
+                _Query(Key const &pLow, Key const &pHigh, bool pPoint) : low(pLow), high(pHigh), point(pPoint) {}
+            };
+
+            tree_type _tree;
+            Compare   _cmp;
+            Allocator _alloc;
+
+            // an interval starting at pLow may still overlap the query
+            bool _startsBefore(_Query const &pQuery, Key const &pLow) const {
+                return pQuery.point ? !_cmp(pQuery.low, pLow) : _cmp(pLow, pQuery.high);
+            }
+
+            // an interval ending at pHigh may still overlap the query
+            bool _endsAfter(_Query const &pQuery, Key const &pHigh) const {
+                return _cmp(pQuery.low, pHigh);
+            }
+
+            // first node of pNode's subtree overlapping the query, NULL if
+            // none. When a node starts before the query ends, so does all of
+            // its left subtree, and that subtree ending after the query
+            // starts means it holds an overlap: one path down is enough
+            tree_node *_firstOverlap(tree_node *pNode, _Query const &pQuery) const {
+                while (pNode && !pNode->isNull && _endsAfter(pQuery, pNode->maxHigh)) {
+                    tree_node *left = pNode->left;
+                    if (!left->isNull && _endsAfter(pQuery, left->maxHigh)) {
+                        pNode = left;
+                        continue ;
+                    }
+                    if (!_startsBefore(pQuery, pNode->value.first.low))
+                        return NULL;
+                    if (_endsAfter(pQuery, pNode->value.first.high))
+                        return pNode;
+                    pNode = pNode->right;
+                }
+                return NULL;
+            }
+
+            // next overlapping node after pNode in order, NULL if none
+            tree_node *_nextOverlap(tree_node *pNode, _Query const &pQuery) const {
+                tree_node *found = _firstOverlap(pNode->right, pQuery);
+                while (!found) {
+                    while (!pNode->isLeftChild)
+                        pNode = pNode->parent;
+                    pNode = pNode->parent;
+                    if (pNode == _tree.end() || !_startsBefore(pQuery, pNode->value.first.low))
+                        return NULL;
+                    if (_endsAfter(pQuery, pNode->value.first.high))
+                        return pNode;
+                    found = _firstOverlap(pNode->right, pQuery);
+                }
+                return found;
+            }
+
+            // calls pVisit on every node of pNode's subtree overlapping the
+            // query, in order. A subtree ending before the query is skipped
+            // whole and the walk stops at the first node starting after it,
+            // only left subtrees recurse so the depth is the tree's height
+            template <class Visitor>
+            void _eachOverlap(tree_node *pNode, _Query const &pQuery, Visitor &pVisit) const {
+                while (pNode && !pNode->isNull && _endsAfter(pQuery, pNode->maxHigh)) {
+                    _eachOverlap(pNode->left, pQuery, pVisit);
+                    if (!_startsBefore(pQuery, pNode->value.first.low))
+                        return ;
+                    if (_endsAfter(pQuery, pNode->value.first.high))
+                        pVisit(pNode);
+                    pNode = pNode->right;
+                }
+            }
+
+            template <class Iterator, class OutputIterator>
+            struct _Collect {
+                OutputIterator out;
+
+                explicit _Collect(OutputIterator pOut) : out(pOut) {}
+
+                void operator()(tree_node *pNode) {
+                    *out++ = Iterator(pNode);
+                }
+            };
+
+            struct _Count {
+                size_t n;
+
+                _Count() : n(0) {}
+
+                void operator()(tree_node *) {
+                    n++;
+                }
+            };
+
+            template <class Iterator, class OutputIterator>
+            OutputIterator _collect(_Query const &pQuery, OutputIterator pOut) const {
+                _Collect<Iterator, OutputIterator> collect(pOut);
+                _eachOverlap(_tree.root(), pQuery, collect);
+                return collect.out;
+            }
+
+            size_t _count(_Query const &pQuery) const {
+                _Count count;
+                _eachOverlap(_tree.root(), pQuery, count);
+                return count.n;
+            }
+
+            tree_node *_node(tree_node *pNode) const {
+                return pNode ? pNode : _tree.end();
+            }
+
+        public:
+            // member types
+            typedef interval<Key>                                  interval_type;
+            typedef interval_type                                  key_type;
+            typedef Key                                            point_type;
+            typedef T                                              mapped_type;
+            typedef pair<const key_type, mapped_type>              value_type;
+            typedef Compare                                        key_compare;
+            typedef Comp                                           value_compare;
+            typedef Allocator                                      allocator_type;
+            typedef typename allocator_type::reference             reference;
+            typedef typename allocator_type::const_reference       const_reference;
+            typedef typename allocator_type::pointer               pointer;
+            typedef typename allocator_type::const_pointer         const_pointer;
+            typedef RBT_Iterator<value_type, value_compare, augment>      iterator;
+            typedef RBT_ConstIterator<value_type, value_compare, augment> const_iterator;
+            typedef ft::reverse_iterator<const_iterator>           const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                 reverse_iterator;
+            typedef ptrdiff_t                                      difference_type;
+            typedef size_t                                         size_type;
+
+            // constuctors
+            explicit interval_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _tree(), _cmp(comp), _alloc(alloc) {}
+
+            template <class InputIterator>
+            interval_map(InputIterator first, InputIterator last, \
+                const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _tree(), _cmp(comp), _alloc(alloc)
+            {
+                insert(first, last);
+            }
+
+            interval_map(const interval_map& x) : _tree(), _cmp(x._cmp), _alloc(x._alloc) {
+                for (const_iterator it = x.begin(); it != x.end(); ++it)
+                    insert(*it);
+            }
+
+            ~interval_map() {}
+
+            interval_map& operator= (const interval_map& x) {
+                if (&x == this)
+                    return *this;
+                _tree.deleteTree();
+                for (const_iterator it = x.begin(); it != x.end(); ++it)
+                    insert(*it);
+                return *this;
+            }
+
+            // iterators
+            iterator begin() {
+                return iterator(_tree.size() == 0 ? _tree.end() : _tree.min());
+            }
+
+            const_iterator begin() const {
+                return const_iterator(_tree.size() == 0 ? _tree.end() : _tree.min());
+            }
+
+            iterator end() {
+                return iterator(_tree.end());
+            }
+
+            const_iterator end() const {
+                return const_iterator(_tree.end());
+            }
+
+            reverse_iterator rbegin() {
+                return reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            reverse_iterator rend() {
+                return reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            bool empty() const {
+                return size() == 0;
+            }
+
+            size_type size() const {
+                return _tree.size();
+            }
+
+            size_type max_size() const {
+                return _tree.max_size();
+            }
+
+            mapped_type& operator[] (const key_type& k) {
+                return _tree.insertNode(value_type(k, mapped_type()))->value.second;
+            }
+
+            // modifiers
+            pair<iterator, bool> insert(const value_type& val) {
+                pair<iterator, bool> ret;
+                ret.first = iterator(_tree.insertNode(val, &(ret.second)));
+                return ret;
+            }
+
+            template <class InputIterator>
+            void insert(InputIterator first, InputIterator last) {
+                for (; first != last; ++first)
+                    insert(*first);
+            }
+
+            void erase(iterator position) {
+                _tree.deleteNode(position._ptr->value, position._ptr);
+            }
+
+            size_type erase(const key_type& k) {
+                return _tree.deleteNode(value_type(k, mapped_type()));
+            }
+
+            void erase(iterator first, iterator last) {
+                _tree.eraseRange(first._ptr, last._ptr);
+            }
+
+            void clear() {
+                _tree.deleteTree();
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            value_compare value_comp() const {
+                return value_compare();
+            }
+
+            // operations
+            iterator find(const key_type& k) {
+                tree_node *node = _tree.findNode(value_type(k, mapped_type()));
+                return iterator(node && !node->isNull ? node : _tree.end());
+            }
+
+            const_iterator find(const key_type& k) const {
+                tree_node *node = _tree.findNode(value_type(k, mapped_type()));
+                return const_iterator(node && !node->isNull ? node : _tree.end());
+            }
+
+            size_type count(const key_type& k) const {
+                return find(k) != end();
+            }
+
+            // overlap queries: an interval overlaps [low, high) when it starts
+            // before high and ends after low, and holds a point when it
+            // starts at or before it and ends after it. first_* returns the
+            // first match in order (end() if none) and next_* the one after
+            // position, so the matches can be walked without a container
+            iterator first_overlap(const interval_type& range) {
+                return iterator(_node(_firstOverlap(_tree.root(), _Query(range.low, range.high, false))));
+            }
+
+            const_iterator first_overlap(const interval_type& range) const {
+                return const_iterator(_node(_firstOverlap(_tree.root(), _Query(range.low, range.high, false))));
+            }
+
+            iterator next_overlap(iterator position, const interval_type& range) {
+                return iterator(_node(_nextOverlap(position._ptr, _Query(range.low, range.high, false))));
+            }
+
+            const_iterator next_overlap(const_iterator position, const interval_type& range) const {
+                return const_iterator(_node(_nextOverlap(position._it._ptr, _Query(range.low, range.high, false))));
+            }
+
+            iterator first_containing(const point_type& point) {
+                return iterator(_node(_firstOverlap(_tree.root(), _Query(point, point, true))));
+            }
+
+            const_iterator first_containing(const point_type& point) const {
+                return const_iterator(_node(_firstOverlap(_tree.root(), _Query(point, point, true))));
+            }
+
+            iterator next_containing(iterator position, const point_type& point) {
+                return iterator(_node(_nextOverlap(position._ptr, _Query(point, point, true))));
+            }
+
+            const_iterator next_containing(const_iterator position, const point_type& point) const {
+                return const_iterator(_node(_nextOverlap(position._it._ptr, _Query(point, point, true))));
+            }
+
+            // writes an iterator to every match, in order
+            template <class OutputIterator>
+            OutputIterator overlapping(const interval_type& range, OutputIterator out) {
+                return _collect<iterator>(_Query(range.low, range.high, false), out);
+            }
+
+            template <class OutputIterator>
+            OutputIterator overlapping(const interval_type& range, OutputIterator out) const {
+                return _collect<const_iterator>(_Query(range.low, range.high, false), out);
+            }
+
+            template <class OutputIterator>
+            OutputIterator containing(const point_type& point, OutputIterator out) {
+                return _collect<iterator>(_Query(point, point, true), out);
+            }
+
+            template <class OutputIterator>
+            OutputIterator containing(const point_type& point, OutputIterator out) const {
+                return _collect<const_iterator>(_Query(point, point, true), out);
+            }
+
+            size_type count_overlapping(const interval_type& range) const {
+                return _count(_Query(range.low, range.high, false));
+            }
+
+            size_type count_containing(const point_type& point) const {
+                return _count(_Query(point, point, true));
+            }
+
+            // allocator
+            allocator_type get_allocator() const {
+                return allocator_type(_alloc);
+            }
+    };
+} // namespace ft
+
+#endif
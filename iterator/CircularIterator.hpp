@@ -0,0 +1,115 @@
+#ifndef _CIRCULARITERATOR_HPP_INCLUDED_
+#define _CIRCULARITERATOR_HPP_INCLUDED_
+#include "common.hpp"
+#include "iterator.hpp"
+
+namespace ft {
+    // the pos-th element of a ring of mask + 1 slots starting at head. It
+    // counts positions from the front, not slots, so order and distance
+    // survive the wrap
+    template <class T>
+    class CircularIterator : public iterator<random_access_iterator_tag, T> {
+        private:
+            T      *_arr;
+            size_t _mask;
+            size_t _head;
+            size_t _pos;
+
+        public:
+            typedef T                          value_type;
+            typedef ptrdiff_t                  difference_type;
+            typedef T*                         pointer;
+            typedef T&                         reference;
+            typedef random_access_iterator_tag iterator_category;
+
+            CircularIterator() : _arr(NULL), _mask(0), _head(0), _pos(0) {}
+
+            CircularIterator(T *pArr, size_t pMask, size_t pHead, size_t pPos)
+                : _arr(pArr), _mask(pMask), _head(pHead), _pos(pPos) {}
+
+            bool operator==(CircularIterator const &rhs) const {
+                return _pos == rhs._pos && _arr == rhs._arr;
+            }
+
+            bool operator!=(CircularIterator const &rhs) const {
+                return !(*this == rhs);
+            }
+
+            reference operator*() const {
+                return _arr[(_head + _pos) & _mask];
+            }
+
+            pointer operator->() const {
+                return &**this;
+            }
+
+            reference operator[](difference_type n) const {
+                return _arr[(_head + _pos + n) & _mask];
+            }
+
+            CircularIterator &operator++() {
+                return _pos++, *this;
+            }
+
+            CircularIterator operator++(int) {
+                CircularIterator tmp(*this);
+                _pos++;
+                return tmp;
+            }
+
+            CircularIterator &operator--() {
+                return _pos--, *this;
+            }
+
+            CircularIterator operator--(int) {
+                CircularIterator tmp(*this);
+                _pos--;
+                return tmp;
+            }
+
+            CircularIterator &operator+=(difference_type n) {
+                _pos += n;
+                return *this;
+            }
+
+            CircularIterator &operator-=(difference_type n) {
+                _pos -= n;
+                return *this;
+            }
+
+            CircularIterator operator+(difference_type n) const {
+                return CircularIterator(_arr, _mask, _head, _pos + n);
+            }
+
+            CircularIterator operator-(difference_type n) const {
+                return CircularIterator(_arr, _mask, _head, _pos - n);
+            }
+
+            difference_type operator-(CircularIterator const &rhs) const {
+                return static_cast<difference_type>(_pos - rhs._pos);
+            }
+
+            bool operator<(CircularIterator const &rhs) const {
+                return _pos < rhs._pos;
+            }
+
+            bool operator>(CircularIterator const &rhs) const {
+                return _pos > rhs._pos;
+            }
+
+            bool operator<=(CircularIterator const &rhs) const {
+                return _pos <= rhs._pos;
+            }
+
+            bool operator>=(CircularIterator const &rhs) const {
+                return _pos >= rhs._pos;
+            }
+    };
+
+    template <class T>
+    CircularIterator<T> operator+(typename CircularIterator<T>::difference_type n, CircularIterator<T> const &rhs) {
+        return rhs + n;
+    }
+} // namespace ft
+
+#endif
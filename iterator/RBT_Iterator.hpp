@@ -1,16 +1,18 @@
+#ifndef _RBT_ITERATOR_HPP_INCLUDED_
+#define _RBT_ITERATOR_HPP_INCLUDED_
 #include "iterator.hpp"
 #include "RedBlackTree.hpp"
 
 namespace ft {
-    template<class T, class Comp>
+    template<class T, class Comp, class Augment = no_augment>
     class RBT_Iterator : \
-        public iterator<bidirectional_iterator_tag, typename RedBlackTree<T, Comp>::Node>
+        public iterator<bidirectional_iterator_tag, typename RedBlackTree<T, Comp, Augment>::Node>
     {
         public:
             typedef T                                     value_type;
             typedef ptrdiff_t                             difference_type;
-            typedef typename RedBlackTree<T, Comp>::Node* pointer;
-            typedef typename RedBlackTree<T, Comp>::Node& reference;
+            typedef typename RedBlackTree<T, Comp, Augment>::Node* pointer;
+            typedef typename RedBlackTree<T, Comp, Augment>::Node& reference;
             typedef bidirectional_iterator_tag            iterator_category;
         
         private:
@@ -119,5 +121,88 @@ namespace ft {
             // friends:
             template<class Key, class X, class Compare, class Allocator>
             friend class map;
+            template<class X, class Compare, class Allocator>
+            friend class set;
+            template<class Key, class X, class Compare, class Allocator>
+            friend class interval_map;
+            template<class Key, class X, class Compare, class Allocator>
+            friend class split_map;
+            template<class X, class Compare, class Aug>
+            friend class RBT_ConstIterator;
+    };
+
+    // walks the tree like RBT_Iterator but only hands out const references,
+    // what a const container gives out. An RBT_Iterator converts to it
+    template<class T, class Comp, class Augment = no_augment>
+    class RBT_ConstIterator : public iterator<bidirectional_iterator_tag, T>
+    {
+        public:
+            typedef T                                     value_type;
+            typedef ptrdiff_t                             difference_type;
+            typedef const T*                              pointer;
+            typedef const T&                              reference;
+            typedef bidirectional_iterator_tag            iterator_category;
+
+        private:
+            RBT_Iterator<T, Comp, Augment> _it;
+
+        public:
+            RBT_ConstIterator() {}
+
+            RBT_ConstIterator(typename RedBlackTree<T, Comp, Augment>::Node *x) : _it(x) {}
+
+            RBT_ConstIterator(RBT_Iterator<T, Comp, Augment> const &obj) : _it(obj) {}
+
+            RBT_ConstIterator(RBT_ConstIterator const &obj) : _it(obj._it) {}
+
+            // operators
+            RBT_ConstIterator &operator=(RBT_ConstIterator const &rhs) {
+                _it = rhs._it;
+                return *this;
+            }
+
+            bool operator==(RBT_ConstIterator const &rhs) const {
+                return _it == rhs._it;
+            }
+
+            bool operator!=(RBT_ConstIterator const &rhs) const {
+                return _it != rhs._it;
+            }
+
+            const value_type &operator*() const {
+                return *_it;
+            }
+
+            const value_type *operator->() const {
+                return &(*_it);
+            }
+
+            RBT_ConstIterator &operator++() {
+                ++_it;
+                return *this;
+            } // pre increment
+
+            RBT_ConstIterator operator++(int) {
+                RBT_ConstIterator tmp(*this);
+                ++_it;
+                return tmp;
+            } // post increment
+
+            RBT_ConstIterator &operator--() {
+                --_it;
+                return *this;
+            } // pre decrement
+
+            RBT_ConstIterator operator--(int) {
+                RBT_ConstIterator tmp(*this);
+                --_it;
+                return tmp;
+            } // post decrement
+
+            // friends:
+            template<class Key, class X, class Compare, class Allocator>
+            friend class interval_map;
     };
 } // namespace ft
+
+#endif
\ No newline at end of file
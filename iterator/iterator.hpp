@@ -56,7 +56,7 @@ namespace ft {
                 current = rhs.current;
             }
 
-            reference operator*() {
+            reference operator*() const {
                 iterator_type tmp(current);
                 return *(--tmp);
             }
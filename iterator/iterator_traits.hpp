@@ -1,6 +1,7 @@
 #ifndef _ITERATOR_TRAITS_HPP_INCLUDED_
 # define _ITERATOR_TRAITS_HPP_INCLUDED_
 # include "common.hpp"
+# include <iterator>
 
 namespace ft {
     // iterator categories
@@ -10,6 +11,40 @@ namespace ft {
     struct bidirectional_iterator_tag : public forward_iterator_tag {};
     struct random_access_iterator_tag : public bidirectional_iterator_tag {};
 
+    namespace detail {
+        // ft's tag for a category, so that iterators of std containers and
+        // streams dispatch like ours
+        template <class Tag>
+        struct ft_category {
+            typedef Tag type;
+        };
+
+        template <>
+        struct ft_category<std::input_iterator_tag> {
+            typedef input_iterator_tag type;
+        };
+
+        template <>
+        struct ft_category<std::output_iterator_tag> {
+            typedef output_iterator_tag type;
+        };
+
+        template <>
+        struct ft_category<std::forward_iterator_tag> {
+            typedef forward_iterator_tag type;
+        };
+
+        template <>
+        struct ft_category<std::bidirectional_iterator_tag> {
+            typedef bidirectional_iterator_tag type;
+        };
+
+        template <>
+        struct ft_category<std::random_access_iterator_tag> {
+            typedef random_access_iterator_tag type;
+        };
+    } // namespace detail
+
     // Generic definition of iterator traits
     template<class Iterator>
     struct iterator_traits {
@@ -17,7 +52,7 @@ namespace ft {
         typedef typename Iterator::value_type        value_type;
         typedef typename Iterator::pointer           pointer;
         typedef typename Iterator::reference         reference;
-        typedef typename Iterator::iterator_category iterator_category;
+        typedef typename detail::ft_category<typename Iterator::iterator_category>::type iterator_category;
     };
 
     // T* specialization of iterator traits
@@ -5,6 +5,7 @@
 #include "RedBlackTree.hpp"
 #include "utility.hpp"
 #include "RBT_Iterator.hpp"
+#include "node_handle.hpp"
 
 namespace ft {
     template<class Key, class T, class Compare = less<Key>,
@@ -21,11 +22,46 @@ namespace ft {
                     }
             };
 
+            // a key against an element, both ways round, for lookups by key
+            class KeyComp {
+                private:
+                    Compare _cmp;
+                public:
+                    KeyComp() : _cmp(Compare()) {}
+                    bool operator()(const Key &lhs, const pair<const Key, T> &rhs) const {
+                        return _cmp(lhs, rhs.first);
+                    }
+                    bool operator()(const pair<const Key, T> &lhs, const Key &rhs) const {
+                        return _cmp(lhs.first, rhs);
+                    }
+            };
+
+            // integral keys under less sort as integers (see insertBatch)
+            struct RadixKey {
+                static const bool enabled = detail::radix_key<Key, Compare>::enabled;
+                uint64_t operator()(const pair<const Key, T> &val) const {
+                    return detail::radix_key<Key, Compare>()(val.first);
+                }
+            };
+
             RedBlackTree<pair<const Key, T>, Comp> _tree;
             Compare                           _cmp;
             Allocator                         _alloc;
 
             typedef RedBlackTree<pair<const Key, T>, Comp>         tree_type;
+
+            friend struct detail::tree_access<map>;
+
+            // looks up to tree_type::findGroupSize keys of first up at once
+            template <class InputIterator>
+            size_t _findGroup(InputIterator &first, InputIterator last, typename tree_type::Node **pNodes) const {
+                key_type keys[tree_type::findGroupSize];
+                size_t   n = 0;
+                for (; n < tree_type::findGroupSize && first != last; ++first)
+                    keys[n++] = *first;
+                _tree.findGroup(keys, pNodes, n, KeyComp());
+                return n;
+            }
         public:
             // member types
             typedef Key                                            key_type;
@@ -44,6 +80,7 @@ namespace ft {
             typedef ft::reverse_iterator<iterator>                 reverse_iterator;
             typedef iterator_traits<iterator>                      difference_type;
             typedef size_t                                         size_type;
+            typedef map_node_handle<typename tree_type::Node, key_type, mapped_type> node_type;
 
 
             // constuctors
@@ -128,8 +165,7 @@ namespace ft {
 
             mapped_type& at(const key_type& k) {
                 typename tree_type::Node *node;
-                value_type to_find(k, mapped_type());
-                node = _tree.findNode(to_find);
+                node = _tree.findNode(k, KeyComp());
                 if (!node || node->isNull) {
                     throw std::out_of_range("map::at");
                 }
@@ -161,23 +197,81 @@ namespace ft {
                 }
             }
 
+            // same result as insert(first, last), but the batch is sorted
+            // (radix sorted for integral keys) and goes into the tree in one
+            // pass instead of a descent per element. Worth it for large
+            // unsorted batches; returns the number of elements inserted
+            template <class InputIterator>
+            size_type bulk_insert(InputIterator first, InputIterator last) {
+                return _tree.insertBatch(first, last, RadixKey());
+            }
+
             void erase(iterator position) {
                 _tree.deleteNode(position._ptr->value, position._ptr);
             }
 
             size_type erase(const key_type& k) {
-                typename tree_type::Node *node;
                 value_type toDelete(k, mapped_type());
                 return _tree.deleteNode(toDelete);
             }
 
             void erase(iterator first, iterator last) {
-                if (first == last)
-                    return ;
-                iterator tmp(first);
-                ++tmp;
-                erase(first);
-                erase(tmp, last);
+                _tree.eraseRange(first._ptr, last._ptr);
+            }
+
+            // node handles: extract cuts an element out without freeing it,
+            // insert links it back, here or into another map, and merge moves
+            // over every element whose key is missing here. None of them
+            // allocates or copies an element
+            node_type extract(iterator position) {
+                return node_type(_tree.extractNode(position._ptr));
+            }
+
+            node_type extract(const key_type& k) {
+                typename tree_type::Node *node = _tree.findNode(k, KeyComp());
+                if (!node || node->isNull)
+                    return node_type();
+                return node_type(_tree.extractNode(node));
+            }
+
+            // nh is emptied if its key was missing, otherwise it keeps the
+            // node and the element in the way is returned
+            pair<iterator, bool> insert(node_type& nh) {
+                if (nh.empty())
+                    return pair<iterator, bool>(end(), false);
+                pair<iterator, bool>      ret;
+                typename tree_type::Node *node;
+                node = _tree.insertDetached(nh._node, &(ret.second));
+                if (ret.second)
+                    nh._release();
+                ret.first = iterator(node);
+                return ret;
+            }
+
+            iterator insert(iterator position, node_type& nh) {
+                (void) position;
+                return insert(nh).first;
+            }
+
+            // elements whose key is already here stay in source
+            void merge(map& source) {
+                _tree.merge(source._tree);
+            }
+
+            // moves every element into one block of memory, in order, so
+            // that later scans and lookups are friendlier to the cache. The
+            // elements are copied once, iterators are invalidated. Returns
+            // the bytes of heap reclaimed
+            size_type compact() {
+                return _tree.compact();
+            }
+
+            // replaces the content with the n elements of first, which must be
+            // sorted by key_comp() without duplicates, in O(n). Throws
+            // invalid_argument if they are not and leaves the content as it was
+            template <class InputIterator>
+            void assign_sorted(InputIterator first, size_type n) {
+                _tree.buildSorted(first, n);
             }
 
             void swap (map& x) {
@@ -210,8 +304,7 @@ namespace ft {
             // operations
             iterator find(const key_type& k) {
                 typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
+                node = _tree.findNode(k, KeyComp());
                 if (!node || node->isNull) {
                     return iterator(_tree.end());
                 }
@@ -220,8 +313,7 @@ namespace ft {
 
             const_iterator find(const key_type& k) const {
                 typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
+                node = _tree.findNode(k, KeyComp());
                 if (!node || node->isNull) {
                     return const_iterator(_tree.end());
                 }
@@ -233,50 +325,47 @@ namespace ft {
                 return find(k) != end();
             }
 
-            iterator lower_bound(const key_type& k) {
-                typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
-                if (!node)
-                    return iterator(_tree.end());
-                if (node->isNull) {
-                    iterator it(node);
-                    return ++it;
+            // batched lookups: the keys of [first, last) are searched for in
+            // groups whose descents interleave (see RedBlackTree::findGroup).
+            // find_many writes an iterator for each key to out, in order,
+            // end() where it is missing; count_many counts the keys present
+            template <class InputIterator, class OutputIterator>
+            OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator out) const {
+                typename tree_type::Node *nodes[tree_type::findGroupSize];
+                while (first != last) {
+                    size_t n = _findGroup(first, last, nodes);
+                    for (size_t i = 0; i < n; i++)
+                        *out++ = iterator(nodes[i] ? nodes[i] : _tree.end());
                 }
-                return iterator(node);
+                return out;
+            }
+
+            template <class InputIterator>
+            size_type count_many(InputIterator first, InputIterator last) const {
+                typename tree_type::Node *nodes[tree_type::findGroupSize];
+                size_type                count = 0;
+                while (first != last) {
+                    size_t n = _findGroup(first, last, nodes);
+                    for (size_t i = 0; i < n; i++)
+                        count += nodes[i] != NULL;
+                }
+                return count;
+            }
+
+            iterator lower_bound(const key_type& k) {
+                return iterator(_tree.lowerBound(k, KeyComp()));
             }
             
             const_iterator lower_bound(const key_type& k) const {
-                typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
-                if (!node)
-                    return const_iterator(_tree.end());
-                if (node->isNull) {
-                    const_iterator it(node);
-                    return ++it;
-                }
-                return const_iterator(node);
+                return const_iterator(_tree.lowerBound(k, KeyComp()));
             }
 
             iterator upper_bound(const key_type& k) {
-                typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
-                if (!node)
-                    return iterator(_tree.end());
-                iterator it(node);
-                return ++it;
+                return iterator(_tree.upperBound(k, KeyComp()));
             }
             
             const_iterator upper_bound(const key_type& k) const {
-                typename tree_type::Node *node;
-                value_type toFind(k, mapped_type());
-                node = _tree.findNode(toFind);
-                if (!node)
-                    return const_iterator(_tree.end());
-                const_iterator it(node);
-                return ++it;
+                return const_iterator(_tree.upperBound(k, KeyComp()));
             }
 
             pair<iterator,iterator> equal_range(const key_type& k) {
@@ -292,6 +381,38 @@ namespace ft {
                 return allocator_type(_alloc);
             }
     };
+
+    // set algebra in place, rhs is consumed: lhs becomes its union,
+    // intersection or difference with rhs and rhs is left empty, its nodes
+    // either moved into lhs or freed. No value is copied or allocated and
+    // where both hold a key lhs keeps its own element. O(m log(n / m + 1))
+    // for sizes m <= n. parallel_set_algebra.hpp adds overloads taking a
+    // thread_pool that combine disjoint subtrees in parallel.
+    template <class Key, class T, class Compare, class Alloc>
+    void merge_union(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        access::tree(lhs).unionWith(access::tree(rhs));
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    void retain_intersection(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        access::tree(lhs).intersectWith(access::tree(rhs));
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    void remove_difference(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        access::tree(lhs).subtract(access::tree(rhs));
+    }
+
+    // erases every element pred holds for in one in-order sweep, then
+    // rebalances once. Returns how many went
+    template <class Key, class T, class Compare, class Alloc, class Predicate>
+    typename map<Key, T, Compare, Alloc>::size_type erase_if(map<Key, T, Compare, Alloc> &c, Predicate pred) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        return access::tree(c).eraseIf(pred);
+    }
 } // namespace ft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef _MPMC_QUEUE_HPP_INCLUDED_
+#define _MPMC_QUEUE_HPP_INCLUDED_
+#include "common.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+    // bounded lock-free FIFO for any number of producers and consumers
+    // (Vyukov's ring). Every cell carries a sequence number telling whose
+    // turn it is: a producer may fill cell i once its sequence equals the
+    // ticket it drew from the enqueue counter, a consumer may empty it once
+    // the sequence is one past that. Producers and consumers only meet on
+    // the cell they hand over, the two counters live on separate cache lines.
+    // The capacity is rounded up to a power of two and never changes.
+    template <class T, class Alloc = std::allocator<T> >
+    class mpmc_queue {
+        public:
+            typedef T      value_type;
+            typedef Alloc  allocator_type;
+            typedef size_t size_type;
+
+        private:
+            struct _Cell {
+                size_t sequence;
+                T      value;
+            };
+
+            typedef typename Alloc::template rebind<_Cell>::other cell_allocator;
+
+            // plain values no wider than a word are stored atomically, so
+            // front() may read a cell that is being refilled
+            typedef integral_constant<bool, is_trivially_copyable<T>::value
+                                            && sizeof(T) <= sizeof(uint64_t)> _WordSized;
+
+            struct _Counter {
+                char   padBefore[64];
+                size_t value;
+                char   padAfter[64];
+
+                _Counter() : value(0) {}
+            };
+
+            _Cell          *_cells;
+            size_t         _mask;
+            _Counter       _enqueue;
+            _Counter       _dequeue;
+            Alloc          _alloc;
+            cell_allocator _cellAlloc;
+
+            mpmc_queue(mpmc_queue const &);
+            mpmc_queue &operator=(mpmc_queue const &);
+
+            void _store(_Cell *cell, const value_type &val, true_type) {
+                value_type value = val;
+                __atomic_store(&cell->value, &value, __ATOMIC_RELAXED);
+            }
+
+            void _store(_Cell *cell, const value_type &val, false_type) {
+                _alloc.construct(&cell->value, val);
+            }
+
+            // empties a claimed cell and hands it to the producer one lap on
+            void _release(_Cell *cell, size_t pos) {
+                _alloc.destroy(&cell->value);
+                __atomic_store_n(&cell->sequence, pos + _mask + 1, __ATOMIC_RELEASE);
+            }
+
+        public:
+            explicit mpmc_queue(size_type capacity, const allocator_type &alloc = allocator_type())
+                : _cells(NULL), _mask(0), _alloc(alloc), _cellAlloc(alloc)
+            {
+                size_t size = 2;
+                while (size < capacity)
+                    size <<= 1;
+                _cells = _cellAlloc.allocate(size);
+                _mask = size - 1;
+                for (size_t i = 0; i < size; i++)
+                    _cells[i].sequence = i;
+            }
+
+            // no other thread may still use the queue
+            ~mpmc_queue() {
+                for (size_t i = _dequeue.value; i != _enqueue.value; i++)
+                    _alloc.destroy(&_cells[i & _mask].value);
+                _cellAlloc.deallocate(_cells, _mask + 1);
+            }
+
+            size_type capacity() const {
+                return _mask + 1;
+            }
+
+            // only hints while other threads push or pop
+            size_type size() const {
+                size_t dequeued = __atomic_load_n(&_dequeue.value, __ATOMIC_RELAXED);
+                size_t enqueued = __atomic_load_n(&_enqueue.value, __ATOMIC_RELAXED);
+                return enqueued > dequeued ? enqueued - dequeued : 0;
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            // false (and nothing pushed) if the queue is full. The cell is
+            // claimed before the value is copied in, so T's copy constructor
+            // must not throw
+            bool push(const value_type &val) {
+                size_t pos = __atomic_load_n(&_enqueue.value, __ATOMIC_RELAXED);
+                _Cell  *cell;
+                while (true) {
+                    cell = &_cells[pos & _mask];
+                    size_t    sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                    ptrdiff_t diff = static_cast<ptrdiff_t>(sequence - pos);
+                    if (diff == 0) {
+                        if (__atomic_compare_exchange_n(&_enqueue.value, &pos, pos + 1, true,
+                                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                            break ;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = __atomic_load_n(&_enqueue.value, __ATOMIC_RELAXED);
+                }
+                _store(cell, val, _WordSized());
+                __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            // copies the oldest element into out and removes it, false if
+            // the queue was empty. The cell is released even if T's copy
+            // assignment throws, the element is lost but the queue goes on
+            bool pop(value_type &out) {
+                size_t pos = __atomic_load_n(&_dequeue.value, __ATOMIC_RELAXED);
+                _Cell  *cell;
+                while (true) {
+                    cell = &_cells[pos & _mask];
+                    size_t    sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                    ptrdiff_t diff = static_cast<ptrdiff_t>(sequence - (pos + 1));
+                    if (diff == 0) {
+                        if (__atomic_compare_exchange_n(&_dequeue.value, &pos, pos + 1, true,
+                                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                            break ;
+                    }
+                    else if (diff < 0)
+                        return false;
+                    else
+                        pos = __atomic_load_n(&_dequeue.value, __ATOMIC_RELAXED);
+                }
+                try {
+                    out = cell->value;
+                } catch (...) {
+                    _release(cell, pos);
+                    throw;
+                }
+                _release(cell, pos);
+                return true;
+            }
+
+            // copies the oldest element into out without removing it, false
+            // if the queue was empty. The cell may be emptied and refilled
+            // while it is read, the copy only counts if the cell's sequence
+            // did not move meanwhile, so like concurrent_stack::top it is
+            // only offered for the plain word sized types push stores
+            // atomically
+            bool front(value_type &out) const {
+                typedef char only_for_word_sized_plain_types[_WordSized::value ? 1 : -1];
+                (void)sizeof(only_for_word_sized_plain_types);
+
+                size_t pos = __atomic_load_n(&_dequeue.value, __ATOMIC_ACQUIRE);
+                while (true) {
+                    const _Cell *cell = &_cells[pos & _mask];
+                    size_t      sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                    ptrdiff_t   diff = static_cast<ptrdiff_t>(sequence - (pos + 1));
+                    if (diff < 0)
+                        return false;
+                    if (diff == 0) {
+                        value_type value;
+                        __atomic_load(&cell->value, &value, __ATOMIC_RELAXED);
+                        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                        if (__atomic_load_n(&cell->sequence, __ATOMIC_RELAXED) == sequence) {
+                            out = value;
+                            return true;
+                        }
+                    }
+                    pos = __atomic_load_n(&_dequeue.value, __ATOMIC_ACQUIRE);
+                }
+            }
+    };
+} // namespace ft
+
+#endif
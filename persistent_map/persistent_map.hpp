@@ -0,0 +1,233 @@
+#ifndef _PERSISTENT_MAP_HPP_INCLUDED_
+#define _PERSISTENT_MAP_HPP_INCLUDED_
+#include "common.hpp"
+#include "functional.hpp"
+#include "algorithm.hpp"
+#include "utility.hpp"
+#include "PersistentRedBlackTree.hpp"
+
+namespace ft {
+    // ordered map whose versions share structure: copying one (or calling
+    // snapshot()) is O(1) and never blocks or disturbs later updates of the
+    // original, an update copies only the O(log n) nodes on its path.
+    // A version can be read from any number of threads at once, a single
+    // persistent_map object must still not be modified concurrently.
+    // Elements are immutable, there is no operator[] and no mutable iterator.
+    template<class Key, class T, class Compare = less<Key> >
+    class persistent_map {
+        private:
+            class Comp {
+                private:
+                    Compare _cmp;
+                public:
+                    Comp() : _cmp(Compare()) {}
+                    bool operator()(const pair<const Key, T> &lhs, const pair<const Key, T> &rhs) const {
+                        return _cmp(lhs.first, rhs.first);
+                    }
+            };
+
+            typedef PersistentRedBlackTree<pair<const Key, T>, Comp> tree_type;
+
+            tree_type _tree;
+            Compare   _cmp;
+
+        public:
+            // member types
+            typedef Key                                            key_type;
+            typedef T                                              mapped_type;
+            typedef pair<const key_type, mapped_type>              value_type;
+            typedef Compare                                        key_compare;
+            typedef Comp                                           value_compare;
+            typedef const value_type&                              reference;
+            typedef const value_type&                              const_reference;
+            typedef typename tree_type::Iterator                   iterator;
+            typedef typename tree_type::Iterator                   const_iterator;
+            typedef ft::reverse_iterator<const_iterator>           const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                 reverse_iterator;
+            typedef ptrdiff_t                                      difference_type;
+            typedef size_t                                         size_type;
+
+            // constructors
+            explicit persistent_map(const key_compare& comp = key_compare()) : _cmp(comp) {}
+
+            template <class InputIterator>
+            persistent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+                : _cmp(comp)
+            {
+                for (; first != last; ++first)
+                    _tree.insertNode(*first);
+            }
+
+            persistent_map(const persistent_map& x) : _tree(x._tree), _cmp(x._cmp) {}
+
+            ~persistent_map() {}
+
+            persistent_map& operator= (const persistent_map& x) {
+                _tree = x._tree;
+                _cmp = x._cmp;
+                return *this;
+            }
+
+            // the current version, O(1)
+            persistent_map snapshot() const {
+                return *this;
+            }
+
+            // iterators, valid as long as some version holding their element lives
+            const_iterator begin() const {
+                return _tree.begin();
+            }
+
+            const_iterator end() const {
+                return _tree.end();
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            bool empty() const {
+                return _tree.size() == 0;
+            }
+
+            size_type size() const {
+                return _tree.size();
+            }
+
+            size_type max_size() const {
+                return _tree.max_size();
+            }
+
+            // element access
+            const mapped_type& at(const key_type& k) const {
+                typename tree_type::Node *node = _tree.findNode(value_type(k, mapped_type()));
+                if (!node)
+                    throw std::out_of_range("persistent_map::at");
+                return node->value.second;
+            }
+
+            // modifiers, each one replaces this object's version and leaves
+            // every other version untouched
+            pair<const_iterator, bool> insert(const value_type& val) {
+                bool inserted = _tree.insertNode(val);
+                return pair<const_iterator, bool>(_tree.find(val), inserted);
+            }
+
+            template <class InputIterator>
+            void insert(InputIterator first, InputIterator last) {
+                for (; first != last; ++first)
+                    _tree.insertNode(*first);
+            }
+
+            // returns true if the key was new
+            bool insert_or_assign(const key_type& k, const mapped_type& obj) {
+                return _tree.insertNode(value_type(k, obj), true);
+            }
+
+            size_type erase(const key_type& k) {
+                return _tree.deleteNode(value_type(k, mapped_type()));
+            }
+
+            void swap(persistent_map& x) {
+                persistent_map tmp(x);
+                x = *this;
+                *this = tmp;
+            }
+
+            void clear() {
+                _tree.deleteTree();
+            }
+
+            // the same modifiers returning the new version instead
+            persistent_map inserted(const value_type& val) const {
+                persistent_map next(*this);
+                next._tree.insertNode(val);
+                return next;
+            }
+
+            persistent_map assigned(const key_type& k, const mapped_type& obj) const {
+                persistent_map next(*this);
+                next._tree.insertNode(value_type(k, obj), true);
+                return next;
+            }
+
+            persistent_map erased(const key_type& k) const {
+                persistent_map next(*this);
+                next._tree.deleteNode(value_type(k, mapped_type()));
+                return next;
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            value_compare value_comp() const {
+                return value_compare();
+            }
+
+            // operations
+            const_iterator find(const key_type& k) const {
+                return _tree.find(value_type(k, mapped_type()));
+            }
+
+            size_type count(const key_type& k) const {
+                return _tree.findNode(value_type(k, mapped_type())) != NULL;
+            }
+
+            const_iterator lower_bound(const key_type& k) const {
+                return _tree.bound(value_type(k, mapped_type()), false);
+            }
+
+            const_iterator upper_bound(const key_type& k) const {
+                return _tree.bound(value_type(k, mapped_type()), true);
+            }
+
+            pair<const_iterator,const_iterator> equal_range(const key_type& k) const {
+                return pair<const_iterator,const_iterator>(lower_bound(k), upper_bound(k));
+            }
+    };
+
+    // relational operators
+    template <class Key, class T, class Compare>
+    bool operator== (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class Key, class T, class Compare>
+    bool operator!= (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class Key, class T, class Compare>
+    bool operator< (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class Key, class T, class Compare>
+    bool operator<= (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <class Key, class T, class Compare>
+    bool operator> (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <class Key, class T, class Compare>
+    bool operator>= (const persistent_map<Key,T,Compare>& lhs, const persistent_map<Key,T,Compare>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    template <class Key, class T, class Compare>
+    void swap(persistent_map<Key,T,Compare>& x, persistent_map<Key,T,Compare>& y) {
+        x.swap(y);
+    }
+} // namespace ft
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef _RCU_MAP_HPP_INCLUDED_
+#define _RCU_MAP_HPP_INCLUDED_
+#include "common.hpp"
+#include <sched.h>
+#include "functional.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include "PersistentRedBlackTree.hpp"
+
+namespace ft {
+    // ordered map for one writer and many readers. The writer builds every
+    // new version with path copying (PersistentRedBlackTree) and publishes
+    // it with a single atomic store of the root pointer, readers load that
+    // pointer and walk an immutable tree: no lock, no atomic read-modify-
+    // write, nothing written to memory shared with other readers.
+    //
+    // Old versions are reclaimed by epochs: each reader owns a slot (its own
+    // cache line) holding the epoch it entered in, or 0 while outside. A
+    // version replaced in epoch E is freed once no slot holds an epoch below
+    // E. Only the writer frees memory, readers never wait.
+    //
+    // Readers go through an rcu_map::reader, which claims a slot for as
+    // long as it lives; one per thread.
+    template<class Key, class T, class Compare = less<Key> >
+    class rcu_map {
+        private:
+            class Comp {
+                private:
+                    Compare _cmp;
+                public:
+                    Comp() : _cmp(Compare()) {}
+                    bool operator()(const pair<const Key, T> &lhs, const pair<const Key, T> &rhs) const {
+                        return _cmp(lhs.first, rhs.first);
+                    }
+            };
+
+            typedef PersistentRedBlackTree<pair<const Key, T>, Comp> tree_type;
+            typedef typename tree_type::Node                          node_type;
+
+        public:
+            // member types
+            typedef Key                                               key_type;
+            typedef T                                                 mapped_type;
+            typedef pair<const key_type, mapped_type>                 value_type;
+            typedef Compare                                           key_compare;
+            typedef size_t                                            size_type;
+            typedef typename tree_type::Iterator                      const_iterator;
+
+        private:
+            struct _Slot {
+                unsigned long epoch;
+                int           used;
+                char          pad[64 - sizeof(unsigned long) - sizeof(int)];
+            };
+
+            struct _Retired {
+                unsigned long epoch;
+                tree_type     version; // keeps the old nodes alive
+
+                _Retired() : epoch(0) {}
+                _Retired(unsigned long pEpoch, tree_type const &pVersion)
+                    : epoch(pEpoch), version(pVersion) {}
+            };
+
+            char              _padBefore[64];
+            node_type         *_root;      // what readers see
+            unsigned long     _epoch;
+            size_type         _size;
+            char              _padAfter[64];
+            _Slot             *_slots;
+            size_type         _slotCount;
+            tree_type         _current;    // writer's copy of the published version
+            const tree_type   _lookup;     // never modified, readers search with it
+            vector<_Retired>  _retired;
+            Compare           _cmp;
+
+            rcu_map(rcu_map const &);
+            rcu_map &operator=(rcu_map const &);
+
+            // writer side
+            void _publish(tree_type const &next) {
+                __atomic_store_n(&_root, next.root(), __ATOMIC_RELEASE);
+                __atomic_store_n(&_size, next.size(), __ATOMIC_RELAXED);
+                unsigned long epoch = __atomic_add_fetch(&_epoch, 1, __ATOMIC_SEQ_CST);
+                _retired.push_back(_Retired(epoch, _current));
+                _current = next;
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                reclaim();
+            }
+
+            unsigned long _oldestReader() const {
+                unsigned long oldest = ~0UL;
+                for (size_type i = 0; i < _slotCount; i++) {
+                    unsigned long epoch = __atomic_load_n(&_slots[i].epoch, __ATOMIC_ACQUIRE);
+                    if (epoch && epoch < oldest)
+                        oldest = epoch;
+                }
+                return oldest;
+            }
+
+            // reader side
+            node_type *_enter(size_type slot) const {
+                __atomic_store_n(&_slots[slot].epoch, __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE), __ATOMIC_RELAXED);
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                return __atomic_load_n(&_root, __ATOMIC_ACQUIRE);
+            }
+
+            void _leave(size_type slot) const {
+                __atomic_store_n(&_slots[slot].epoch, 0UL, __ATOMIC_RELEASE);
+            }
+
+        public:
+            // a registered reader thread
+            class reader {
+                private:
+                    const rcu_map *_map;
+                    size_type     _slot;
+
+                    reader(reader const &);
+                    reader &operator=(reader const &);
+
+                public:
+                    // throws std::runtime_error when every slot is taken
+                    explicit reader(const rcu_map &m) : _map(&m), _slot(0) {
+                        for (; _slot < m._slotCount; _slot++) {
+                            if (__sync_bool_compare_and_swap(&m._slots[_slot].used, 0, 1))
+                                return ;
+                        }
+                        throw std::runtime_error("rcu_map: too many readers");
+                    }
+
+                    ~reader() {
+                        __atomic_store_n(&_map->_slots[_slot].used, 0, __ATOMIC_RELEASE);
+                    }
+
+                    bool find(const key_type &k, mapped_type &out) const {
+                        node_type *node = _map->_lookup.findNode(value_type(k, mapped_type()), _map->_enter(_slot));
+                        if (node)
+                            out = node->value.second;
+                        _map->_leave(_slot);
+                        return node != NULL;
+                    }
+
+                    size_type count(const key_type &k) const {
+                        node_type *node = _map->_lookup.findNode(value_type(k, mapped_type()), _map->_enter(_slot));
+                        _map->_leave(_slot);
+                        return node != NULL;
+                    }
+
+                    // calls f(const value_type&) on one version, in key order
+                    template <class Function>
+                    Function for_each(Function f) const {
+                        node_type *root = _map->_enter(_slot);
+                        try {
+                            for (const_iterator it = tree_type::begin(root); it != tree_type::end(root); ++it)
+                                f(*it);
+                        } catch (...) {
+                            _map->_leave(_slot);
+                            throw;
+                        }
+                        _map->_leave(_slot);
+                        return f;
+                    }
+            };
+
+            explicit rcu_map(size_type max_readers = 64, const key_compare &comp = key_compare())
+                : _root(NULL), _epoch(1), _size(0), _slots(NULL), _slotCount(max_readers ? max_readers : 1), _cmp(comp)
+            {
+                _slots = new _Slot[_slotCount];
+                for (size_type i = 0; i < _slotCount; i++) {
+                    _slots[i].epoch = 0;
+                    _slots[i].used = 0;
+                }
+            }
+
+            // no reader may be left
+            ~rcu_map() {
+                delete[] _slots;
+            }
+
+            // capacity, as last published
+            size_type size() const {
+                return __atomic_load_n(&_size, __ATOMIC_RELAXED);
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            // modifiers, writer thread only
+            bool insert(const value_type &val) {
+                tree_type next(_current);
+                if (!next.insertNode(val))
+                    return false;
+                _publish(next);
+                return true;
+            }
+
+            // returns true if the key was new
+            bool insert_or_assign(const key_type &k, const mapped_type &obj) {
+                tree_type next(_current);
+                bool      inserted = next.insertNode(value_type(k, obj), true);
+                _publish(next);
+                return inserted;
+            }
+
+            size_type erase(const key_type &k) {
+                tree_type next(_current);
+                if (!next.deleteNode(value_type(k, mapped_type())))
+                    return 0;
+                _publish(next);
+                return 1;
+            }
+
+            void clear() {
+                _publish(tree_type());
+            }
+
+            // frees the versions no reader can see anymore, returns how many
+            // are still waiting. Every update already calls it.
+            size_type reclaim() {
+                unsigned long oldest = _oldestReader();
+                size_type     kept = 0;
+                for (size_type i = 0; i < _retired.size(); i++) {
+                    if (_retired[i].epoch > oldest)
+                        _retired[kept++] = _retired[i];
+                }
+                while (_retired.size() > kept)
+                    _retired.pop_back();
+                return kept;
+            }
+
+            // waits until every replaced version is freed
+            void synchronize() {
+                while (reclaim())
+                    sched_yield();
+            }
+
+            // the writer can read its own version without a slot
+            bool find(const key_type &k, mapped_type &out) const {
+                node_type *node = _current.findNode(value_type(k, mapped_type()));
+                if (node)
+                    out = node->value.second;
+                return node != NULL;
+            }
+
+            size_type count(const key_type &k) const {
+                return _current.findNode(value_type(k, mapped_type())) != NULL;
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            size_type max_readers() const {
+                return _slotCount;
+            }
+    };
+} // namespace ft
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef _PERSISTENTREDBLACKTREE_HPP_INCLUDED_
+#define _PERSISTENTREDBLACKTREE_HPP_INCLUDED_
+#include "common.hpp"
+#include "iterator.hpp"
+
+namespace ft {
+    // Immutable left leaning red-black tree. Nodes are reference counted and
+    // never modified once they are reachable from more than one version:
+    // every update copies the nodes on its search path (plus the few
+    // siblings a rotation touches) and shares every other subtree with the
+    // version it started from. Copying a tree is O(1), an update allocates
+    // O(log n) nodes. Nodes have no parent links since they can have many
+    // parents, iterators keep the path from the root instead.
+    //
+    // Internally every function takes ownership of the node references it
+    // receives and hands back an owned reference.
+    template <class T, class Comp>
+    class PersistentRedBlackTree {
+        public:
+            class Node {
+                public:
+                    T            value;
+                    Node         *left;
+                    Node         *right;
+                    bool         isRed;
+                    mutable long refs;
+
+                    Node(T const &pValue, Node *pLeft, Node *pRight, bool pIsRed)
+                        : value(pValue), left(pLeft), right(pRight), isRed(pIsRed), refs(1) {}
+            };
+
+            // the deepest path of a left leaning red-black tree is at most
+            // twice the shallowest one, 128 levels hold any addressable size
+            static const int maxDepth = 128;
+
+            class Iterator : public iterator<bidirectional_iterator_tag, T, ptrdiff_t, const T*, const T&> {
+                private:
+                    Node *_root;
+                    Node *_path[maxDepth];
+                    int  _depth;
+
+                    void _pushLeftmost(Node *node) {
+                        for (; node; node = node->left)
+                            _path[_depth++] = node;
+                    }
+
+                    void _pushRightmost(Node *node) {
+                        for (; node; node = node->right)
+                            _path[_depth++] = node;
+                    }
+
+                    friend class PersistentRedBlackTree;
+
+                public:
+                    Iterator() : _root(NULL), _depth(0) {}
+
+                    explicit Iterator(Node *root) : _root(root), _depth(0) {}
+
+                    Iterator(Iterator const &obj) : _root(obj._root), _depth(obj._depth) {
+                        for (int i = 0; i < _depth; i++)
+                            _path[i] = obj._path[i];
+                    }
+
+                    Iterator &operator=(Iterator const &rhs) {
+                        _root = rhs._root;
+                        _depth = rhs._depth;
+                        for (int i = 0; i < _depth; i++)
+                            _path[i] = rhs._path[i];
+                        return *this;
+                    }
+
+                    bool operator==(Iterator const &rhs) const {
+                        return node() == rhs.node();
+                    }
+
+                    bool operator!=(Iterator const &rhs) const {
+                        return node() != rhs.node();
+                    }
+
+                    const T &operator*() const {
+                        return _path[_depth - 1]->value;
+                    }
+
+                    const T *operator->() const {
+                        return &_path[_depth - 1]->value;
+                    }
+
+                    Iterator &operator++() {
+                        Node *current = _path[_depth - 1];
+                        if (current->right) {
+                            _pushLeftmost(current->right);
+                            return *this;
+                        }
+                        while (--_depth > 0 && _path[_depth - 1]->right == _path[_depth])
+                            ;
+                        return *this;
+                    } // pre increment
+
+                    Iterator operator++(int) {
+                        Iterator tmp(*this);
+                        ++(*this);
+                        return tmp;
+                    } // post increment
+
+                    Iterator &operator--() {
+                        if (_depth == 0) {
+                            _pushRightmost(_root);
+                            return *this;
+                        }
+                        Node *current = _path[_depth - 1];
+                        if (current->left) {
+                            _pushRightmost(current->left);
+                            return *this;
+                        }
+                        while (--_depth > 0 && _path[_depth - 1]->left == _path[_depth])
+                            ;
+                        return *this;
+                    } // pre decrement
+
+                    Iterator operator--(int) {
+                        Iterator tmp(*this);
+                        --(*this);
+                        return tmp;
+                    } // post decrement
+
+                    Node *node() const {
+                        return _depth ? _path[_depth - 1] : NULL;
+                    }
+            };
+
+        private:
+            Node                 *_root;
+            size_t               _size;
+            Comp                 _cmp;
+            std::allocator<Node> _alloc;
+
+            static bool _isRed(Node *node) {
+                return node && node->isRed;
+            }
+
+            static Node *_retain(Node *node) {
+                if (node)
+                    __sync_add_and_fetch(&node->refs, 1);
+                return node;
+            }
+
+            void _release(Node *node) {
+                while (node && __sync_sub_and_fetch(&node->refs, 1) == 0) {
+                    Node *right = node->right;
+                    _release(node->left);
+                    _alloc.destroy(node);
+                    _alloc.deallocate(node, 1);
+                    node = right;
+                }
+            }
+
+            Node *_make(T const &pValue, Node *pLeft, Node *pRight, bool pIsRed) {
+                Node *node = _alloc.allocate(1);
+                _alloc.construct(node, Node(pValue, pLeft, pRight, pIsRed));
+                return node;
+            }
+
+            // makes sure nobody else sees the node we are about to modify
+            Node *_unshare(Node *node) {
+                if (!node || __atomic_load_n(&node->refs, __ATOMIC_ACQUIRE) == 1)
+                    return node;
+                Node *copy = _make(node->value, _retain(node->left), _retain(node->right), node->isRed);
+                _release(node);
+                return copy;
+            }
+
+            // same node, different value: the value of a map entry is
+            // const so it cannot be assigned
+            Node *_replaceValue(Node *node, T const &pValue) {
+                Node *copy = _make(pValue, node->left, node->right, node->isRed);
+                node->left = NULL;
+                node->right = NULL;
+                _release(node);
+                return copy;
+            }
+
+            Node *_rotateLeft(Node *node) {
+                node->right = _unshare(node->right);
+                Node *right = node->right;
+                node->right = right->left;
+                right->left = node;
+                right->isRed = node->isRed;
+                node->isRed = true;
+                return right;
+            }
+
+            Node *_rotateRight(Node *node) {
+                node->left = _unshare(node->left);
+                Node *left = node->left;
+                node->left = left->right;
+                left->right = node;
+                left->isRed = node->isRed;
+                node->isRed = true;
+                return left;
+            }
+
+            void _flipColors(Node *node) {
+                node->left = _unshare(node->left);
+                node->right = _unshare(node->right);
+                node->isRed = !node->isRed;
+                node->left->isRed = !node->left->isRed;
+                node->right->isRed = !node->right->isRed;
+            }
+
+            Node *_balance(Node *node) {
+                if (_isRed(node->right) && !_isRed(node->left))
+                    node = _rotateLeft(node);
+                if (_isRed(node->left) && _isRed(node->left->left))
+                    node = _rotateRight(node);
+                if (_isRed(node->left) && _isRed(node->right))
+                    _flipColors(node);
+                return node;
+            }
+
+            Node *_moveRedLeft(Node *node) {
+                _flipColors(node);
+                if (_isRed(node->right->left)) {
+                    node->right = _rotateRight(_unshare(node->right));
+                    node = _rotateLeft(node);
+                    _flipColors(node);
+                }
+                return node;
+            }
+
+            Node *_moveRedRight(Node *node) {
+                _flipColors(node);
+                if (_isRed(node->left->left)) {
+                    node = _rotateRight(node);
+                    _flipColors(node);
+                }
+                return node;
+            }
+
+            // pValue must not be in the tree, or replace must be set
+            Node *_insert(Node *node, T const &pValue, bool replace) {
+                if (!node)
+                    return _make(pValue, NULL, NULL, true);
+                node = _unshare(node);
+                if (_cmp(pValue, node->value))
+                    node->left = _insert(node->left, pValue, replace);
+                else if (_cmp(node->value, pValue))
+                    node->right = _insert(node->right, pValue, replace);
+                else
+                    node = _replaceValue(node, pValue);
+                return _balance(node);
+            }
+
+            Node *_deleteMin(Node *node, Node **pMin) {
+                node = _unshare(node);
+                if (!node->left) {
+                    *pMin = node;
+                    return NULL;
+                }
+                if (!_isRed(node->left) && !_isRed(node->left->left))
+                    node = _moveRedLeft(node);
+                node->left = _deleteMin(node->left, pMin);
+                return _balance(node);
+            }
+
+            // pValue must be in the tree
+            Node *_delete(Node *node, T const &pValue) {
+                node = _unshare(node);
+                if (_cmp(pValue, node->value)) {
+                    if (!_isRed(node->left) && !_isRed(node->left->left))
+                        node = _moveRedLeft(node);
+                    node->left = _delete(node->left, pValue);
+                    return _balance(node);
+                }
+                if (_isRed(node->left))
+                    node = _rotateRight(node);
+                if (!_cmp(node->value, pValue) && !node->right) {
+                    Node *left = node->left;
+                    node->left = NULL;
+                    _release(node);
+                    return left;
+                }
+                if (!_isRed(node->right) && !_isRed(node->right->left))
+                    node = _moveRedRight(node);
+                if (!_cmp(node->value, pValue)) {
+                    Node *min = NULL;
+                    node->right = _deleteMin(node->right, &min);
+                    node = _replaceValue(node, min->value);
+                    min->right = NULL; // min had no left child and keeps no right one
+                    _release(min);
+                }
+                else
+                    node->right = _delete(node->right, pValue);
+                return _balance(node);
+            }
+
+        public:
+            PersistentRedBlackTree() : _root(NULL), _size(0), _cmp(Comp()) {}
+
+            // O(1), the new tree shares every node with obj
+            PersistentRedBlackTree(PersistentRedBlackTree const &obj)
+                : _root(_retain(obj._root)), _size(obj._size), _cmp(obj._cmp) {}
+
+            PersistentRedBlackTree &operator=(PersistentRedBlackTree const &rhs) {
+                Node *old = _root;
+                _root = _retain(rhs._root);
+                _size = rhs._size;
+                _cmp = rhs._cmp;
+                _release(old);
+                return *this;
+            }
+
+            ~PersistentRedBlackTree() {
+                _release(_root);
+            }
+
+            // returns false (and changes nothing) if an equivalent value
+            // is already there and replace is false
+            bool insertNode(T const &pValue, bool replace = false) {
+                bool exists = findNode(pValue) != NULL;
+                if (exists && !replace)
+                    return false;
+                _root = _insert(_root, pValue, replace);
+                _root->isRed = false;
+                if (!exists)
+                    _size++;
+                return !exists;
+            }
+
+            size_t deleteNode(T const &pValue) {
+                if (!findNode(pValue))
+                    return 0;
+                _root = _unshare(_root);
+                if (!_isRed(_root->left) && !_isRed(_root->right))
+                    _root->isRed = true;
+                _root = _delete(_root, pValue);
+                if (_root)
+                    _root->isRed = false;
+                _size--;
+                return 1;
+            }
+
+            Node *findNode(T const &pValue) const {
+                return findNode(pValue, _root);
+            }
+
+            // lookups in another version of this tree, readers that got hold
+            // of a root pointer without a tree use these
+            Node *findNode(T const &pValue, Node *root) const {
+                Node *current = root;
+                while (current) {
+                    if (_cmp(pValue, current->value))
+                        current = current->left;
+                    else if (_cmp(current->value, pValue))
+                        current = current->right;
+                    else
+                        return current;
+                }
+                return NULL;
+            }
+
+            void deleteTree() {
+                _release(_root);
+                _root = NULL;
+                _size = 0;
+            }
+
+            size_t size() const {
+                return _size;
+            }
+
+            size_t max_size() const {
+                return _alloc.max_size();
+            }
+
+            Node *root() const {
+                return _root;
+            }
+
+            // iterators
+            Iterator begin() const {
+                return begin(_root);
+            }
+
+            Iterator end() const {
+                return Iterator(_root);
+            }
+
+            static Iterator begin(Node *root) {
+                Iterator it(root);
+                it._pushLeftmost(root);
+                return it;
+            }
+
+            static Iterator end(Node *root) {
+                return Iterator(root);
+            }
+
+            Iterator find(T const &pValue) const {
+                Iterator it(_root);
+                for (Node *current = _root; current; ) {
+                    it._path[it._depth++] = current;
+                    if (_cmp(pValue, current->value))
+                        current = current->left;
+                    else if (_cmp(current->value, pValue))
+                        current = current->right;
+                    else
+                        return it;
+                }
+                return end();
+            }
+
+            // first value not less than pValue (upper: first value greater)
+            Iterator bound(T const &pValue, bool upper) const {
+                Iterator it(_root);
+                int      found = 0;
+                for (Node *current = _root; current; ) {
+                    it._path[it._depth++] = current;
+                    bool goLeft = upper ? _cmp(pValue, current->value) : !_cmp(current->value, pValue);
+                    if (goLeft) {
+                        found = it._depth;
+                        current = current->left;
+                    }
+                    else
+                        current = current->right;
+                }
+                it._depth = found;
+                return it;
+            }
+    };
+} // namespace ft
+
+#endif
@@ -1,12 +1,137 @@
 #ifndef _REDBLACKTREE_HPP_INCLUDED_
 #define _REDBLACKTREE_HPP_INCLUDED_
 #include "common.hpp"
+#include "vector.hpp"
+#include <cstdlib>
+#include <new>
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
 
 namespace ft {
-    template <class T, class Comp> 
+    // runs two jobs one after the other, the fork/join operations of the
+    // tree take it or a parallel one (see thread_pool's pool_invoke)
+    struct sequential_invoke {
+        template <class Function1, class Function2>
+        void operator()(Function1 &f, Function2 &g) const {
+            f();
+            g();
+        }
+    };
+
+    namespace detail {
+        // lets the free functions working on map's and set's trees (set
+        // algebra) reach them, the containers befriend it
+        template <class Container>
+        struct tree_access {
+            static typename Container::tree_type &tree(Container &c) {
+                return c._tree;
+            }
+        };
+
+        // what an allocation of pSize bytes at pPointer takes up on the
+        // heap, glibc's chunk header included
+        inline size_t heap_bytes(void *pPointer, size_t pSize) {
+#ifdef __GLIBC__
+            (void)pSize;
+            return malloc_usable_size(pPointer) + sizeof(size_t);
+#else
+            (void)pPointer;
+            return pSize;
+#endif
+        }
+
+        struct compact_header {
+            compact_header *first;
+            size_t         live;
+            size_t         bytes;
+        };
+
+        // where compact() moves a tree's nodes: one allocation cut into
+        // 64 KiB slabs aligned to their size, each opening with a header.
+        // A node finds its slab by masking its own address, the slab finds
+        // the first one, which counts the nodes still alive: the last node
+        // released frees the whole allocation, whichever tree it is in by then
+        template <class Node>
+        class compact_arena {
+            private:
+                static const size_t _slabSize = 1 << 16;
+
+                compact_header *_first;
+                char           *_slab;
+                size_t         _used;
+
+                compact_arena(compact_arena const &);
+                compact_arena &operator=(compact_arena const &);
+
+                static size_t _offset() {
+                    size_t align = __alignof__(Node);
+                    return (sizeof(compact_header) + align - 1) / align * align;
+                }
+
+            public:
+                static size_t perSlab() {
+                    return (_slabSize - _offset()) / sizeof(Node);
+                }
+
+                // room for pCount nodes, perSlab() must not be 0
+                explicit compact_arena(size_t pCount) : _first(NULL), _slab(NULL), _used(0) {
+                    size_t slabs = (pCount + perSlab() - 1) / perSlab();
+                    void   *memory;
+                    if (posix_memalign(&memory, _slabSize, slabs * _slabSize))
+                        throw std::bad_alloc();
+                    _first = static_cast<compact_header*>(memory);
+                    _first->live = 0;
+                    _first->bytes = slabs * _slabSize;
+                    _slab = static_cast<char*>(memory);
+                    for (size_t i = 0; i < slabs; i++)
+                        reinterpret_cast<compact_header*>(_slab + i * _slabSize)->first = _first;
+                }
+
+                size_t bytes() const {
+                    return _first->bytes;
+                }
+
+                // storage for the next node, in address order
+                Node *next() {
+                    if (_used == perSlab()) {
+                        _slab += _slabSize;
+                        _used = 0;
+                    }
+                    _first->live++;
+                    return reinterpret_cast<Node*>(_slab + _offset()) + _used++;
+                }
+
+                // destroys a node stored in an arena, returns the bytes
+                // freed (the whole arena once its last node is gone)
+                static size_t release(Node *pNode) {
+                    uintptr_t      address = reinterpret_cast<uintptr_t>(pNode);
+                    compact_header *first = reinterpret_cast<compact_header*>(address & ~uintptr_t(_slabSize - 1))->first;
+                    pNode->~Node();
+                    if (--first->live)
+                        return 0;
+                    size_t bytes = first->bytes;
+                    free(first);
+                    return bytes;
+                }
+        };
+    } // namespace detail
+
+    // what a RedBlackTree keeps in each node besides the value (node_data,
+    // a base of Node) and how it is recomputed from the node's value and
+    // children. The tree calls update on every node whose subtree changed,
+    // children first. The default keeps nothing
+    struct no_augment {
+        struct node_data {};
+
+        template <class Node>
+        static void update(Node *) {}
+    };
+
+    template <class T, class Comp, class Augment = no_augment> 
     class RedBlackTree {
         public:
-            class Node {
+            class Node : public Augment::node_data {
                 private:
                     Comp                 _comp;
                     std::allocator<Node> _alloc;
@@ -23,6 +148,7 @@ namespace ft {
                     Node           *parent;
                     bool           isLeftChild;
                     bool           isNull;
+                    bool           pooled; // lives in a compact() arena
                 
                     Node(std::allocator<Node>& pAlloc, T const &pValue, bool pIsNull=false) : _alloc(pAlloc), value(pValue) {
                         _comp = Comp();
@@ -47,9 +173,10 @@ namespace ft {
                         }
                         isLeftChild = false;
                         isNull = pIsNull;
+                        pooled = false;
                     }
 
-                    Node(Node const &src) : _alloc(src._alloc), value(src.value) {
+                    Node(Node const &src) : Augment::node_data(src), _alloc(src._alloc), value(src.value) {
                         _comp = src._comp;
                         color = src.color;
                         right = src.right;
@@ -57,6 +184,7 @@ namespace ft {
                         parent = src.parent;
                         isLeftChild = src.isLeftChild;
                         isNull = src.isNull;
+                        pooled = false;
                         if (!isNull) {
                             left->parent = this;
                             right->parent = this;
@@ -65,12 +193,25 @@ namespace ft {
 
                     ~Node() {}
 
+                    // every node is freed through here, whether the
+                    // allocator or a compact() arena holds it. Returns the
+                    // bytes the heap got back
+                    static size_t release(Node *pNode) {
+                        if (!pNode)
+                            return 0;
+                        if (pNode->pooled)
+                            return detail::compact_arena<Node>::release(pNode);
+                        std::allocator<Node> alloc;
+                        size_t               bytes = detail::heap_bytes(pNode, sizeof(Node));
+                        alloc.destroy(pNode);
+                        alloc.deallocate(pNode, 1);
+                        return bytes;
+                    }
+
                     void updateLeft(Node *pLeft, bool pDelete=false) {
                         if (isNull) return;
-                        if (left->isNull && pDelete) {
-                            _alloc.destroy(left);
-                            _alloc.deallocate(left, 1);
-                        }
+                        if (left->isNull && pDelete)
+                            release(left);
                         left = pLeft;
                         left->parent = this;
                         left->isLeftChild = true;
@@ -78,10 +219,8 @@ namespace ft {
 
                     void updateRight(Node *pRight, bool pDelete=false) {
                         if (isNull) return;
-                        if (right->isNull && pDelete) {
-                            _alloc.destroy(right);
-                            _alloc.deallocate(right, 1);
-                        }
+                        if (right->isNull && pDelete)
+                            release(right);
                         right = pRight;
                         right->parent = this;
                         right->isLeftChild = false;
@@ -120,17 +259,265 @@ namespace ft {
             std::allocator<Node>    _alloc;
 
         private:
-            void _deleteTree(Node *pNode) {
-                if (!pNode) return;
-                if (pNode->isNull) {
-                    _alloc.destroy(pNode);
-                    _alloc.deallocate(pNode, 1);
-                    return;
+            // returns the bytes the heap got back
+            size_t _deleteTree(Node *pNode) {
+                if (!pNode) return 0;
+                if (pNode->isNull)
+                    return Node::release(pNode);
+                size_t bytes = _deleteTree(pNode->left);
+                bytes += _deleteTree(pNode->right);
+                return bytes + Node::release(pNode);
+            }
+
+            // frees a detached subtree without recursing: a node with a
+            // left child is rotated right until it has none, then goes
+            // with its left leaf and the walk moves on to its right.
+            // Returns the number of values freed
+            static size_t _sweepTree(Node *pNode) {
+                size_t count = 0;
+                while (!pNode->isNull) {
+                    Node *left = pNode->left;
+                    if (!left->isNull) {
+                        pNode->left = left->right;
+                        left->right = pNode;
+                        pNode = left;
+                        continue ;
+                    }
+                    Node *right = pNode->right;
+                    Node::release(left);
+                    Node::release(pNode);
+                    pNode = right;
+                    count++;
+                }
+                Node::release(pNode);
+                return count;
+            }
+
+            // what an eraseIf sweep has kept: the nodes in order, chained
+            // through their right links, and the leaves it took off them,
+            // chained through their parent links
+            struct _Survivors {
+                Node   *head;
+                Node   **tail;
+                Node   *leaves;
+                size_t count;
+            };
+
+            struct _KeepAll {
+                bool operator()(T const &) const {
+                    return false;
+                }
+            };
+
+            // flattens pNode in order the way _sweepTree does, freeing the
+            // values pPred holds for and keeping the others. pNode is the
+            // part still to sweep whenever pPred is called, so if it throws
+            // no node is lost
+            template <class Predicate>
+            static size_t _sweepIf(Node *&pNode, _Survivors &pKept, Predicate &pPred) {
+                size_t erased = 0;
+                while (!pNode->isNull) {
+                    Node *left = pNode->left;
+                    if (!left->isNull) {
+                        pNode->left = left->right;
+                        left->right = pNode;
+                        pNode = left;
+                        continue ;
+                    }
+                    Node *node = pNode;
+                    bool drop = pPred(node->value);
+                    pNode = node->right;
+                    if (drop) {
+                        Node::release(node);
+                        erased++;
+                    } else {
+                        *pKept.tail = node;
+                        pKept.tail = &node->right;
+                        pKept.count++;
+                    }
+                    left->parent = pKept.leaves;
+                    pKept.leaves = left;
+                }
+                return erased;
+            }
+
+            // _buildSorted for nodes that already exist: links the next n
+            // of the list at pHead, taking the leaves from pLeaves
+            static Node *_buildFromList(Node *&pHead, Node *&pLeaves, size_t n, size_t depth, size_t redDepth) {
+                if (n == 0) {
+                    Node *leaf = pLeaves;
+                    pLeaves = leaf->parent;
+                    leaf->color = Node::Black;
+                    return leaf;
+                }
+                size_t leftSize = (n - 1) / 2;
+                Node *left = _buildFromList(pHead, pLeaves, leftSize, depth + 1, redDepth);
+                Node *node = pHead;
+                pHead = node->right;
+                Node *right = _buildFromList(pHead, pLeaves, n - 1 - leftSize, depth + 1, redDepth);
+                node->color = depth == redDepth ? Node::Red : Node::Black;
+                return _link(node, left, right);
+            }
+
+            // pLast is the leaf the sweep ended on, one more than the
+            // survivors need; the leaves of erased nodes are freed
+            void _rebuild(Node *pLast, _Survivors &pKept) {
+                pLast->parent = pKept.leaves;
+                pKept.leaves = pLast;
+                size_t redDepth = 0;
+                while (((size_t)2 << redDepth) <= pKept.count + 1)
+                    redDepth++;
+                Node *root = _buildFromList(pKept.head, pKept.leaves, pKept.count, 0, redDepth);
+                while (pKept.leaves) {
+                    Node *leaf = pKept.leaves;
+                    pKept.leaves = leaf->parent;
+                    Node::release(leaf);
+                }
+                _setRoot(root, pKept.count);
+            }
+
+            // insertBatch: the nodes of the batch are sorted, then linked
+            // one after the other or, when the batch outnumbers the tree's
+            // nodes by this much, merged with them
+            static const size_t _batchRebuildRatio = 2;
+
+            struct _NodeLess {
+                Comp cmp;
+                bool operator()(Node *pLhs, Node *pRhs) const {
+                    return cmp(pLhs->value, pRhs->value);
+                }
+            };
+
+            template <class Radix>
+            void _sortBatch(vector<Node*> &pBatch, Radix &, false_type) {
+                vector<Node*> buffer(pBatch.size());
+                _NodeLess     less;
+                less.cmp = _cmp;
+                detail::merge_sort(&pBatch[0], &pBatch[0] + pBatch.size(), &buffer[0], less);
+            }
+
+            // the keys are read once into an array that is sorted on its
+            // own, no node is touched while sorting
+            template <class Radix>
+            void _sortBatch(vector<Node*> &pBatch, Radix &pRadix, true_type) {
+                size_t                             n = pBatch.size();
+                vector<detail::radix_item<Node*> > items(n);
+                vector<detail::radix_item<Node*> > buffer(n);
+                for (size_t i = 0; i < n; i++) {
+                    items[i].key = pRadix(pBatch[i]->value);
+                    items[i].value = pBatch[i];
+                }
+                detail::radix_sort(&items[0], &items[0] + n, &buffer[0]);
+                for (size_t i = 0; i < n; i++)
+                    pBatch[i] = items[i].value;
+            }
+
+            // keeps the first of every run of equal nodes, frees the others
+            size_t _uniqueBatch(vector<Node*> &pBatch) {
+                size_t n = 0;
+                for (size_t i = 0; i < pBatch.size(); i++) {
+                    if (n && !_cmp(pBatch[n - 1]->value, pBatch[i]->value))
+                        _sweepTree(pBatch[i]);
+                    else
+                        pBatch[n++] = pBatch[i];
+                }
+                return n;
+            }
+
+            // where pValue goes: the node holding it, or the leaf to link it
+            // at. The search starts from pFrom, a node ordered before
+            // pValue, climbing only as far as the first ancestor ordered
+            // after it, so values close together in order find each other
+            // in a few steps
+            Node *_findFrom(Node *pFrom, T const &pValue) const {
+                Node *node = pFrom;
+                while (node != _root) {
+                    Node *parent = node->parent;
+                    if (node->isLeftChild) {
+                        if (_cmp(pValue, parent->value))
+                            break ;
+                        if (!_cmp(parent->value, pValue))
+                            return parent;
+                    }
+                    node = parent;
+                }
+                while (!node->isNull) {
+                    if (_cmp(pValue, node->value))
+                        node = node->left;
+                    else if (_cmp(node->value, pValue))
+                        node = node->right;
+                    else
+                        break ;
+                }
+                return node;
+            }
+
+            // links the n sorted, unique nodes of pNodes one after the
+            // other, each searched for from the one before
+            size_t _linkBatch(Node **pNodes, size_t n) {
+                size_t inserted = 0;
+                size_t i = 0;
+                Node   *finger = _root;
+                try {
+                    for (; i < n; i++) {
+                        Node *node = pNodes[i];
+                        Node *position = _root ? _findFrom(finger, node->value) : NULL;
+                        if (position && !position->isNull) {
+                            _sweepTree(node);
+                            finger = position;
+                            continue ;
+                        }
+                        Node::release(node->left);
+                        node->left = NULL;
+                        _linkDetached(position, node);
+                        finger = node;
+                        inserted++;
+                    }
+                } catch (...) {
+                    for (; i < n; i++)
+                        _sweepTree(pNodes[i]);
+                    throw;
                 }
-                _deleteTree(pNode->left);
-                _deleteTree(pNode->right);
-                _alloc.destroy(pNode);
-                _alloc.deallocate(pNode, 1);
+                return inserted;
+            }
+
+            // lays the tree out as a list, merges the n sorted, unique nodes
+            // of pNodes into it and builds a balanced tree of the lot. Where
+            // both hold a value the tree's node stays. O(size() + n)
+            size_t _mergeBatch(Node **pNodes, size_t n) {
+                _Survivors old = { NULL, NULL, NULL, 0 };
+                old.tail = &old.head;
+                Node     *rest = _takeRoot();
+                _KeepAll keepAll;
+                _sweepIf(rest, old, keepAll);
+                *old.tail = NULL;
+
+                _Survivors merged = { NULL, NULL, old.leaves, 0 };
+                merged.tail = &merged.head;
+                size_t     inserted = 0;
+                size_t     i = 0;
+                Node       *node = old.head;
+                while (node || i < n) {
+                    Node *next;
+                    if (!node || (i < n && _cmp(pNodes[i]->value, node->value))) {
+                        next = pNodes[i++];
+                        next->left->parent = merged.leaves;
+                        next->right->parent = next->left;
+                        merged.leaves = next->right;
+                        inserted++;
+                    }
+                    else {
+                        if (i < n && !_cmp(node->value, pNodes[i]->value))
+                            _sweepTree(pNodes[i++]);
+                        next = node;
+                        node = node->right;
+                    }
+                    *merged.tail = next;
+                    merged.tail = &next->right;
+                    merged.count++;
+                }
+                _rebuild(rest, merged);
+                return inserted;
             }
 
             void _rotateLeft(Node *pNode) {
@@ -153,6 +540,8 @@ namespace ft {
                 node->updateRight(rightLeft);
 
                 rightLeft->isLeftChild = false;
+                Augment::update(node);
+                Augment::update(right);
             }
 
             void _rotateRight(Node *pNode) {
@@ -175,6 +564,8 @@ namespace ft {
                 node->updateLeft(leftRight);
 
                 leftRight->isLeftChild = true;
+                Augment::update(node);
+                Augment::update(left);
             }
 
             Node *_getUncel(Node *pNode) const {
@@ -192,8 +583,7 @@ namespace ft {
 
             void _updateRoot(Node *pNode) {
                 if (pNode->isNull) {
-                    _alloc.destroy(pNode);
-                    _alloc.deallocate(pNode, 1);
+                    Node::release(pNode);
                     _root = NULL;
                     return;
                 }
@@ -204,6 +594,11 @@ namespace ft {
                 _end->left = _root; 
             }
 
+            void _updatePath(Node *pNode) {
+                for (; pNode != _end; pNode = pNode->parent)
+                    Augment::update(pNode);
+            }
+
             void _insertFixup(Node *pNode) {
                 if (pNode->color == Node::Black)
                     return;
@@ -399,9 +794,429 @@ namespace ft {
                 else {
                     parent->updateRight(newNode);
                 }
-                _alloc.destroy(pPos);
-                _alloc.deallocate(pPos, 1);
+                Node::release(pPos);
+            }
+            // builds a perfectly balanced subtree out of the next n values of
+            // first (in order), only the nodes at redDepth are red so every
+            // path to a leaf sees the same number of black nodes. pPrev is
+            // the node built last, each value must sort after it. If first
+            // throws, or a value is out of order, whatever was built of the
+            // subtree is freed before the exception leaves
+            template <class InputIterator>
+            Node *_buildSorted(InputIterator &first, Node *&pPrev, size_t n, size_t depth, size_t redDepth) {
+                if (n == 0)
+                    return NULL;
+                size_t leftSize = (n - 1) / 2;
+                Node *left = _buildSorted(first, pPrev, leftSize, depth + 1, redDepth);
+                Node *node;
+                try {
+                    T const &value = *first;
+                    if (pPrev && !_cmp(pPrev->value, value))
+                        throw std::invalid_argument("buildSorted: values not strictly ascending");
+                    node = _alloc.allocate(1);
+                    _alloc.construct(node, Node(_alloc, value));
+                } catch (...) {
+                    if (left)
+                        _sweepTree(left);
+                    throw;
+                }
+                if (left)
+                    node->updateLeft(left, true);
+                pPrev = node;
+                Node *right;
+                try {
+                    ++first;
+                    right = _buildSorted(first, pPrev, n - 1 - leftSize, depth + 1, redDepth);
+                } catch (...) {
+                    _sweepTree(node);
+                    throw;
+                }
+                node->color = depth == redDepth ? Node::Red : Node::Black;
+                if (right)
+                    node->updateRight(right, true);
+                Augment::update(node);
+                return node;
+            }
+
+            // split and join work on detached subtrees: a subtree is a node
+            // whose parent link is meaningless, an empty one is a leaf. Both
+            // only relink nodes, the only allocation is the leaf an empty
+            // subtree needs when it is split in two.
+            Node *_newLeaf() {
+                Node *leaf = _alloc.allocate(1);
+                _alloc.construct(leaf, Node(_alloc, T(), true));
+                return leaf;
+            }
+
+            void _freeNode(Node *pNode) {
+                Node::release(pNode);
+            }
+
+            Node *_takeRoot() {
+                Node *root = _root ? _root : _newLeaf();
+                _root = NULL;
+                _end->left = NULL;
+                _size = 0;
+                return root;
+            }
+
+            void _setRoot(Node *pRoot, size_t pSize) {
+                _updateRoot(pRoot);
+                if (!_root)
+                    _end->left = NULL;
+                _size = pSize;
+            }
+
+            static size_t _blackHeight(Node *pNode) {
+                size_t height = 0;
+                for (; !pNode->isNull; pNode = pNode->left)
+                    height += pNode->color == Node::Black;
+                return height;
+            }
+
+            // unlike Node::updateLeft these never look at the old child,
+            // which may already be freed or belong to another subtree
+            static void _setLeft(Node *pNode, Node *pChild) {
+                pNode->left = pChild;
+                pChild->parent = pNode;
+                pChild->isLeftChild = true;
+            }
+
+            static void _setRight(Node *pNode, Node *pChild) {
+                pNode->right = pChild;
+                pChild->parent = pNode;
+                pChild->isLeftChild = false;
+            }
+
+            static Node *_link(Node *pNode, Node *pLeft, Node *pRight) {
+                _setLeft(pNode, pLeft);
+                _setRight(pNode, pRight);
+                Augment::update(pNode);
+                return pNode;
+            }
+
+            static Node *_rotateLeftDetached(Node *pNode) {
+                Node *right = pNode->right;
+                _setRight(pNode, right->left);
+                _setLeft(right, pNode);
+                Augment::update(pNode);
+                Augment::update(right);
+                return right;
+            }
+
+            static Node *_rotateRightDetached(Node *pNode) {
+                Node *left = pNode->left;
+                _setLeft(pNode, left->right);
+                _setRight(left, pNode);
+                Augment::update(pNode);
+                Augment::update(left);
+                return left;
+            }
+
+            // hangs pMiddle and pRight off the right spine of pLeft, at the
+            // first black node as high as pRight, then repairs red-red pairs
+            // on the way back up
+            static Node *_joinRight(Node *pLeft, size_t pLeftHeight, Node *pMiddle, Node *pRight, size_t pRightHeight) {
+                if (pLeft->color == Node::Black && pLeftHeight == pRightHeight) {
+                    pMiddle->color = Node::Red;
+                    return _link(pMiddle, pLeft, pRight);
+                }
+                size_t childHeight = pLeftHeight - (pLeft->color == Node::Black);
+                _setRight(pLeft, _joinRight(pLeft->right, childHeight, pMiddle, pRight, pRightHeight));
+                Augment::update(pLeft);
+                if (pLeft->color == Node::Black && pLeft->right->color == Node::Red
+                    && pLeft->right->right->color == Node::Red)
+                {
+                    pLeft->right->right->color = Node::Black;
+                    return _rotateLeftDetached(pLeft);
+                }
+                return pLeft;
+            }
+
+            static Node *_joinLeft(Node *pLeft, size_t pLeftHeight, Node *pMiddle, Node *pRight, size_t pRightHeight) {
+                if (pRight->color == Node::Black && pLeftHeight == pRightHeight) {
+                    pMiddle->color = Node::Red;
+                    return _link(pMiddle, pLeft, pRight);
+                }
+                size_t childHeight = pRightHeight - (pRight->color == Node::Black);
+                _setLeft(pRight, _joinLeft(pLeft, pLeftHeight, pMiddle, pRight->left, childHeight));
+                Augment::update(pRight);
+                if (pRight->color == Node::Black && pRight->left->color == Node::Red
+                    && pRight->left->left->color == Node::Red)
+                {
+                    pRight->left->left->color = Node::Black;
+                    return _rotateRightDetached(pRight);
+                }
+                return pRight;
+            }
+
+            // one tree out of pLeft, pMiddle and pRight, in that order, in
+            // O(difference of their heights)
+            static Node *_join(Node *pLeft, Node *pMiddle, Node *pRight) {
+                pLeft->color = Node::Black;
+                pRight->color = Node::Black;
+                size_t leftHeight = _blackHeight(pLeft);
+                size_t rightHeight = _blackHeight(pRight);
+                Node   *joined;
+                if (leftHeight > rightHeight) {
+                    joined = _joinRight(pLeft, leftHeight, pMiddle, pRight, rightHeight);
+                    if (joined->color == Node::Red && joined->right->color == Node::Red)
+                        joined->color = Node::Black;
+                }
+                else if (leftHeight < rightHeight) {
+                    joined = _joinLeft(pLeft, leftHeight, pMiddle, pRight, rightHeight);
+                    if (joined->color == Node::Red && joined->left->color == Node::Red)
+                        joined->color = Node::Black;
+                }
+                else {
+                    pMiddle->color = Node::Red;
+                    joined = _link(pMiddle, pLeft, pRight);
+                }
+                return joined;
+            }
+
+            // detaches the last node of pNode, returns what remains
+            Node *_splitLast(Node *pNode, Node *&pLast) {
+                Node *left = pNode->left;
+                Node *right = pNode->right;
+                if (right->isNull) {
+                    _freeNode(right);
+                    pLast = pNode;
+                    return left;
+                }
+                return _join(left, pNode, _splitLast(right, pLast));
+            }
+
+            Node *_join2(Node *pLeft, Node *pRight) {
+                if (pLeft->isNull) {
+                    _freeNode(pLeft);
+                    return pRight;
+                }
+                Node *last;
+                pLeft = _splitLast(pLeft, last);
+                return _join(pLeft, last, pRight);
+            }
+
+            // cuts pNode into the values before pValue and the values after
+            // it, returns the detached node equal to pValue or NULL
+            Node *_split(Node *pNode, T const &pValue, Node *&pLess, Node *&pGreater) {
+                if (pNode->isNull) {
+                    pLess = pNode;
+                    pGreater = _newLeaf();
+                    return NULL;
+                }
+                Node *left = pNode->left;
+                Node *right = pNode->right;
+                if (_cmp(pValue, pNode->value)) {
+                    Node *found = _split(left, pValue, pLess, pGreater);
+                    pGreater = _join(pGreater, pNode, right);
+                    return found;
+                }
+                if (_cmp(pNode->value, pValue)) {
+                    Node *found = _split(right, pValue, pLess, pGreater);
+                    pLess = _join(left, pNode, pLess);
+                    return found;
+                }
+                pLess = left;
+                pGreater = right;
+                return pNode;
+            }
+
+            size_t _countAtMost(Node *pNode, size_t pLimit) const {
+                if (pNode->isNull || pLimit == 0)
+                    return 0;
+                size_t left = _countAtMost(pNode->left, pLimit);
+                if (left >= pLimit)
+                    return pLimit;
+                return left + 1 + _countAtMost(pNode->right, pLimit - left - 1);
+            }
+
+            // union, intersection and difference of two subtrees (Blelloch,
+            // Ferizovic and Sun, "Just Join for Parallel Ordered Sets"): split
+            // one tree by the other's root, recurse on the two halves, join.
+            // O(m log(n / m + 1)) for sizes m <= n. pCount receives the
+            // duplicates dropped (union), the nodes kept (intersection) or
+            // the nodes removed (difference).
+            enum _SetOperation { _Union, _Intersection, _Difference };
+
+            template <class Invoke>
+            struct _SetTask {
+                RedBlackTree  *tree;
+                _SetOperation operation;
+                Node          *a;
+                Node          *b;
+                Invoke        *invoke;
+                size_t        forks;
+                size_t        count;
+                Node          *result;
+
+                _SetTask(RedBlackTree *pTree, _SetOperation pOperation, Node *pA, Node *pB, Invoke *pInvoke, size_t pForks)
+                    : tree(pTree), operation(pOperation), a(pA), b(pB), invoke(pInvoke), forks(pForks), count(0), result(NULL) {}
+
+                void operator()() {
+                    result = tree->_setOperation(operation, a, b, count, *invoke, forks);
+                }
+            };
+
+            template <class Invoke>
+            Node *_setOperation(_SetOperation pOperation, Node *pA, Node *pB, size_t &pCount, Invoke &pInvoke, size_t pForks) {
+                if (pA->isNull || pB->isNull) {
+                    Node *empty = pA->isNull ? pA : pB;
+                    Node *other = pA->isNull ? pB : pA;
+                    if (pOperation == _Union) {
+                        _freeNode(empty);
+                        return other;
+                    }
+                    if (pOperation == _Intersection || pA->isNull) {
+                        _deleteTree(other);
+                        return empty;
+                    }
+                    _freeNode(pB);
+                    return pA;
+                }
+                // the tree that is split and the one whose root becomes the pivot
+                Node *pivot = pOperation == _Difference ? pB : pA;
+                Node *less;
+                Node *greater;
+                Node *found = _split(pOperation == _Difference ? pA : pB, pivot->value, less, greater);
+                _SetTask<Invoke> left(this, pOperation, pOperation == _Difference ? less : pivot->left,
+                                      pOperation == _Difference ? pivot->left : less, &pInvoke, pForks ? pForks - 1 : 0);
+                _SetTask<Invoke> right(this, pOperation, pOperation == _Difference ? greater : pivot->right,
+                                       pOperation == _Difference ? pivot->right : greater, &pInvoke, pForks ? pForks - 1 : 0);
+                if (pForks)
+                    pInvoke(left, right);
+                else {
+                    left();
+                    right();
+                }
+                pCount += left.count + right.count;
+                if (pOperation == _Union) {
+                    if (found) {
+                        _freeNode(found);
+                        pCount++;
+                    }
+                    return _join(left.result, pivot, right.result);
+                }
+                if (pOperation == _Intersection) {
+                    if (found) {
+                        _freeNode(found);
+                        pCount++;
+                        return _join(left.result, pivot, right.result);
+                    }
+                    _freeNode(pivot);
+                    return _join2(left.result, right.result);
+                }
+                _freeNode(pivot);
+                if (found) {
+                    _freeNode(found);
+                    pCount++;
+                }
+                return _join2(left.result, right.result);
+            }
+
+            template <class Invoke>
+            void _setOperation(_SetOperation pOperation, RedBlackTree &pOther, Invoke pInvoke, size_t pForks) {
+                if (&pOther == this) {
+                    if (pOperation == _Difference)
+                        deleteTree();
+                    return ;
+                }
+                size_t size = _size;
+                size_t otherSize = pOther._size;
+                size_t count = 0;
+                Node   *a = _takeRoot();
+                Node   *root = _setOperation(pOperation, a, pOther._takeRoot(), count, pInvoke, pForks);
+                if (pOperation == _Union)
+                    _setRoot(root, size + otherSize - count);
+                else if (pOperation == _Intersection)
+                    _setRoot(root, count);
+                else
+                    _setRoot(root, size - count);
             }
+
+            // copies pNode's subtree into pArena in order, each leaf right
+            // before its parent or after it, and returns the copy
+            Node *_compactCopy(Node *pNode, detail::compact_arena<Node> &pArena) {
+                if (pNode->isNull) {
+                    Node *leaf = pArena.next();
+                    _alloc.construct(leaf, *pNode);
+                    leaf->pooled = true;
+                    return leaf;
+                }
+                Node *left = _compactCopy(pNode->left, pArena);
+                Node *node = pArena.next();
+                _alloc.construct(node, *pNode);
+                node->pooled = true;
+                _setLeft(node, left);
+                _setRight(node, _compactCopy(pNode->right, pArena));
+                return node;
+            }
+
+            // a node cut out by extractNode keeps one of its leaves as right
+            // child (left is NULL): a tree of n nodes has n + 1 leaves, so
+            // unlinking a node frees one leaf and linking one needs one more.
+            // Only the empty tree, which has none, is handed a new leaf.
+            // Before being unlinked a node with two children trades places
+            // and colors with its predecessor, which has at most one
+            void _swapWithPredecessor(Node *pNode, Node *pPred) {
+                Node *parent = pNode->parent;
+                bool isLeftChild = pNode->isLeftChild;
+                Node *left = pNode->left;
+                Node *right = pNode->right;
+                Node *predParent = pPred->parent;
+                Node *predLeft = pPred->left;
+                Node *predRight = pPred->right;
+
+                _swap(pNode->color, pPred->color);
+                if (isLeftChild)
+                    _setLeft(parent, pPred);
+                else
+                    _setRight(parent, pPred);
+                if (_root == pNode)
+                    _root = pPred;
+                _setRight(pPred, right);
+                if (left == pPred)
+                    _setLeft(pPred, pNode);
+                else {
+                    _setLeft(pPred, left);
+                    _setRight(predParent, pNode);
+                }
+                _setLeft(pNode, predLeft);
+                _setRight(pNode, predRight);
+            }
+
+            void _linkDetached(Node *pPosition, Node *pNode) {
+                pNode->color = Node::Red;
+                if (!pPosition) {
+                    _setLeft(pNode, _newLeaf());
+                    Augment::update(pNode);
+                    _updateRoot(pNode);
+                }
+                else {
+                    Node *parent = pPosition->parent;
+                    if (pPosition->isLeftChild)
+                        _setLeft(parent, pNode);
+                    else
+                        _setRight(parent, pNode);
+                    _setLeft(pNode, pPosition);
+                    _updatePath(pNode);
+                    _insertFixup(pNode);
+                }
+                _size++;
+            }
+
+            static Node *_successor(Node *pNode) {
+                if (!pNode->right->isNull) {
+                    pNode = pNode->right;
+                    while (!pNode->left->isNull)
+                        pNode = pNode->left;
+                    return pNode;
+                }
+                while (!pNode->isLeftChild)
+                    pNode = pNode->parent;
+                return pNode->parent;
+            }
+
 #ifdef DEBUG
             size_t _getBlackHeight(Node *node) const {
                 if (!node || node->isNull) return 0;
@@ -463,8 +1278,7 @@ namespace ft {
                 if (_root) {
                     _deleteTree(_root);
                 }
-                _alloc.destroy(_end);
-                _alloc.deallocate(_end, 1);
+                Node::release(_end);
             }
 
             void deleteTree() {
@@ -474,6 +1288,263 @@ namespace ft {
                _end->left = NULL; 
             }
 
+            // replaces the content with the n values of first, which must be
+            // sorted and unique, in O(n) with one comparison per value to
+            // check it. The new tree is built on the side, so if that throws
+            // (invalid_argument for values out of order) the old one stays
+            template <class InputIterator>
+            void buildSorted(InputIterator first, size_t n) {
+                Node *root = NULL;
+                if (n != 0) {
+                    size_t redDepth = 0;
+                    while (((size_t)2 << redDepth) <= n + 1)
+                        redDepth++;
+                    Node *prev = NULL;
+                    root = _buildSorted(first, prev, n, 0, redDepth);
+                }
+                deleteTree();
+                if (root) {
+                    _updateRoot(root);
+                    _size = n;
+                }
+            }
+
+            // moves every node, leaves included, into one block of memory
+            // in order, so scans and descents walk it forwards instead of
+            // hopping around the heap. Each value is copied once (C++98 has
+            // no move), iterators are invalidated. Returns the heap bytes
+            // given back net of the new block, 0 if it is not smaller
+            size_t compact() {
+                if (!_root || detail::compact_arena<Node>::perSlab() == 0)
+                    return 0;
+                detail::compact_arena<Node> arena(2 * _size + 1);
+                Node   *root = _compactCopy(_root, arena);
+                size_t freed = _deleteTree(_root);
+                _updateRoot(root);
+                return freed > arena.bytes() ? freed - arena.bytes() : 0;
+            }
+
+            // cuts the tree in two: this one keeps the values ordered before
+            // pValue, pRight receives pValue if present and every value after
+            // it (its own content is deleted). The cut costs O(log n), the
+            // new sizes are found by counting the smaller part.
+            void split(T const &pValue, RedBlackTree &pRight) {
+                if (&pRight == this)
+                    return ;
+                pRight.deleteTree();
+                size_t total = _size;
+                Node   *less;
+                Node   *greater;
+                Node   *found = _split(_takeRoot(), pValue, less, greater);
+                if (found)
+                    greater = _join(_newLeaf(), found, greater);
+                size_t lessSize = 0;
+                for (size_t limit = 64; ; limit *= 2) {
+                    if ((lessSize = _countAtMost(less, limit)) < limit)
+                        break ;
+                    size_t greaterSize = _countAtMost(greater, limit);
+                    if (greaterSize < limit) {
+                        lessSize = total - greaterSize;
+                        break ;
+                    }
+                }
+                _setRoot(less, lessSize);
+                pRight._setRoot(greater, total - lessSize);
+            }
+
+            // appends every value of pRight, which must all be ordered after
+            // the values of this tree, in O(log n). pRight is left empty
+            void join(RedBlackTree &pRight) {
+                if (&pRight == this)
+                    return ;
+                size_t size = _size + pRight._size;
+                Node   *right = pRight._takeRoot();
+                _setRoot(_join2(_takeRoot(), right), size);
+            }
+
+            // erases [pFirst, pLast) in O(log n + k) for k values: two
+            // splits cut the range out as one subtree, a join puts the rest
+            // back together and the range is freed in a single sweep. pLast
+            // may be end()
+            size_t eraseRange(Node *pFirst, Node *pLast) {
+                if (pFirst == pLast)
+                    return 0;
+                size_t total = _size;
+                Node   *less;
+                Node   *greater;
+                Node   *range;
+                _split(_takeRoot(), pFirst->value, less, greater);
+                if (pLast == _end) {
+                    range = greater;
+                    greater = _newLeaf();
+                }
+                else {
+                    Node *last = _split(greater, pLast->value, range, greater);
+                    greater = _join(_newLeaf(), last, greater);
+                }
+                Node::release(pFirst);
+                size_t erased = 1 + _sweepTree(range);
+                _setRoot(_join2(less, greater), total - erased);
+                return erased;
+            }
+
+            // erases every value pPred holds for in O(n): one in-order sweep
+            // lays the tree out as a list without them, then the survivors
+            // are relinked into a balanced tree. Nothing is copied and no
+            // erase is rebalanced on its own. Returns how many went
+            template <class Predicate>
+            size_t eraseIf(Predicate pPred) {
+                if (!_root)
+                    return 0;
+                _Survivors kept = { NULL, NULL, NULL, 0 };
+                kept.tail = &kept.head;
+                Node   *rest = _takeRoot();
+                size_t erased;
+                try {
+                    erased = _sweepIf(rest, kept, pPred);
+                } catch (...) {
+                    _KeepAll keepAll;
+                    _sweepIf(rest, kept, keepAll);
+                    _rebuild(rest, kept);
+                    throw;
+                }
+                _rebuild(rest, kept);
+                return erased;
+            }
+
+            // inserts the values of [first, last) as insertNode would one by
+            // one, the first of equal values winning, but sorts them first.
+            // The batch then goes in in order, each value searched for from
+            // the one before rather than from the root, or, when it is at
+            // least twice the tree's size, is merged with it into a rebuilt
+            // tree. When pRadix.enabled, pRadix maps values to integers in
+            // the same order and the batch is radix sorted. Returns the
+            // number of values inserted
+            template <class InputIterator, class Radix>
+            size_t insertBatch(InputIterator first, InputIterator last, Radix pRadix) {
+                vector<Node*> batch;
+                try {
+                    for (; first != last; ++first) {
+                        batch.push_back(NULL);
+                        Node *node = _alloc.allocate(1);
+                        _alloc.construct(node, Node(_alloc, *first));
+                        batch.back() = node;
+                    }
+                    if (batch.size() > 1)
+                        _sortBatch(batch, pRadix, integral_constant<bool, Radix::enabled>());
+                } catch (...) {
+                    for (size_t i = 0; i < batch.size(); i++) {
+                        if (batch[i])
+                            _sweepTree(batch[i]);
+                    }
+                    throw;
+                }
+                size_t n = _uniqueBatch(batch);
+                if (n == 0)
+                    return 0;
+                if (n / _batchRebuildRatio >= _size)
+                    return _mergeBatch(&batch[0], n);
+                return _linkBatch(&batch[0], n);
+            }
+
+            // set algebra in place: this tree becomes the union, intersection
+            // or difference with pOther, which is left empty. Nodes move from
+            // one tree to the other, values are neither copied nor allocated
+            // and where both trees hold a value this tree's node is kept.
+            // pInvoke runs the two halves of the first pForks levels of the
+            // recursion, which work on disjoint subtrees.
+            void unionWith(RedBlackTree &pOther) {
+                _setOperation(_Union, pOther, sequential_invoke(), 0);
+            }
+
+            template <class Invoke>
+            void unionWith(RedBlackTree &pOther, Invoke pInvoke, size_t pForks) {
+                _setOperation(_Union, pOther, pInvoke, pForks);
+            }
+
+            void intersectWith(RedBlackTree &pOther) {
+                _setOperation(_Intersection, pOther, sequential_invoke(), 0);
+            }
+
+            template <class Invoke>
+            void intersectWith(RedBlackTree &pOther, Invoke pInvoke, size_t pForks) {
+                _setOperation(_Intersection, pOther, pInvoke, pForks);
+            }
+
+            void subtract(RedBlackTree &pOther) {
+                _setOperation(_Difference, pOther, sequential_invoke(), 0);
+            }
+
+            template <class Invoke>
+            void subtract(RedBlackTree &pOther, Invoke pInvoke, size_t pForks) {
+                _setOperation(_Difference, pOther, pInvoke, pForks);
+            }
+
+            // unlinks pNode without freeing it or touching its value, see
+            // _swapWithPredecessor for the shape of the detached node.
+            // Iterators to every other node stay valid
+            Node *extractNode(Node *pNode) {
+                if (!pNode || pNode->isNull)
+                    return NULL;
+                if (!pNode->left->isNull && !pNode->right->isNull)
+                    _swapWithPredecessor(pNode, _getPredecessor(pNode));
+                Node *child = pNode->left->isNull ? pNode->right : pNode->left;
+                Node *spare = pNode->left->isNull ? pNode->left : pNode->right;
+                typename Node::color_t \
+                    original_color = pNode->color;
+
+                if (_root == pNode && child->isNull) {
+                    _freeNode(child);
+                    _root = NULL;
+                    _end->left = NULL;
+                }
+                else {
+                    if (pNode->isLeftChild)
+                        _setLeft(pNode->parent, child);
+                    else
+                        _setRight(pNode->parent, child);
+                    if (_root == pNode)
+                        _updateRoot(child);
+                    _updatePath(child->parent);
+                    _deleteFixup(child, original_color);
+                }
+                pNode->left = NULL;
+                _setRight(pNode, spare);
+                pNode->parent = NULL;
+                pNode->isLeftChild = false;
+                _size--;
+                return pNode;
+            }
+
+            // links a node detached by extractNode (from this tree or another
+            // with the same comparison), unless its value is already here:
+            // then the node stays detached and the one in the way is returned
+            Node *insertDetached(Node *pNode, bool *insrtd = NULL) {
+                Node *nodePos = findNode(pNode->value);
+                if (nodePos && !nodePos->isNull) {
+                    if (insrtd) *insrtd = false;
+                    return nodePos;
+                }
+                if (insrtd) *insrtd = true;
+                _linkDetached(nodePos, pNode);
+                return pNode;
+            }
+
+            // moves every node of pSource whose value this tree lacks, the
+            // others stay in pSource
+            void merge(RedBlackTree &pSource) {
+                if (&pSource == this || !pSource._root)
+                    return ;
+                Node *node = pSource.min();
+                while (node != pSource._end) {
+                    Node *next = _successor(node);
+                    Node *nodePos = findNode(node->value);
+                    if (!nodePos || nodePos->isNull)
+                        _linkDetached(nodePos, pSource.extractNode(node));
+                    node = next;
+                }
+            }
+
             Node *insertNode(T const &pValue, bool *insrtd = NULL) {
                 Node *nodePos = findNode(pValue);
                 if (nodePos && !nodePos->isNull) {
@@ -484,6 +1555,7 @@ namespace ft {
                 Node *newNode = _alloc.allocate(1);
                 _alloc.construct(newNode, Node(_alloc, pValue));
                 if (!nodePos) {
+                    Augment::update(newNode);
                     _updateRoot(newNode);
                     _size++;
                     return newNode;
@@ -495,25 +1567,125 @@ namespace ft {
                 else {
                     parent->updateRight(newNode, true);
                 }
+                _updatePath(newNode);
                 _insertFixup(newNode);
                 _size++;
                 return newNode;
             }
 
+            // looks up pCount <= findGroupSize values at once: pNodes[i] is
+            // set to the node holding pValues[i], NULL if there is none.
+            // Every round moves each unfinished search one level down and
+            // prefetches the node it will compare against next, so the
+            // cache misses of the group overlap instead of queueing. Like
+            // findNode it compares once per level; pLess compares a value
+            // with a T both ways round
+            static const size_t findGroupSize = 16;
+
+            template <class Value, class Less>
+            void findGroup(Value const *pValues, Node **pNodes, size_t pCount, Less const &pLess) const {
+                Node   *candidates[findGroupSize];
+                size_t pending[findGroupSize];
+                size_t active = 0;
+                for (size_t i = 0; i < pCount; i++) {
+                    pNodes[i] = _root;
+                    candidates[i] = NULL;
+                    if (_root)
+                        pending[active++] = i;
+                }
+                while (active) {
+                    size_t next = 0;
+                    for (size_t j = 0; j < active; j++) {
+                        size_t i = pending[j];
+                        Node   *node = pNodes[i];
+                        if (node->isNull) {
+                            Node *candidate = candidates[i];
+                            pNodes[i] = candidate && !pLess(pValues[i], candidate->value) ? candidate : NULL;
+                            continue ;
+                        }
+                        if (pLess(node->value, pValues[i]))
+                            node = node->right;
+                        else {
+                            candidates[i] = node;
+                            node = node->left;
+                        }
+                        __builtin_prefetch(node);
+                        pNodes[i] = node;
+                        pending[next++] = i;
+                    }
+                    active = next;
+                }
+            }
+
+            // the descents compare once per level: they only ask whether a
+            // node is ordered before the key (after, for upperBound) and
+            // remember the last one that is not, equality is settled by a
+            // single comparison at the leaf. A hit goes down to the leaf
+            // too, which in a balanced tree is about one level further.
+            // Each also takes any key pLess can order against a T both ways
+            // round, map looks up a key without building a pair around it
+
+            // the node holding pValue, else the leaf where it would go (NULL
+            // when the tree is empty)
             Node *findNode(T const &pValue) const {
+                return findNode(pValue, _cmp);
+            }
+
+            template <class Key, class Less>
+            Node *findNode(Key const &pKey, Less const &pLess) const {
                 if (!_root)
                     return _root;
                 Node *current = _root;
-                while (true) {
-                    if (current->isNull
-                        || (!_cmp(pValue, current->value) 
-                        && !_cmp(current->value, pValue)))
-                        return current;
-                    if (_cmp(pValue, current->value))
+                Node *candidate = NULL;
+                while (!current->isNull) {
+                    if (pLess(current->value, pKey))
+                        current = current->right;
+                    else {
+                        candidate = current;
                         current = current->left;
+                    }
+                }
+                if (candidate && !pLess(pKey, candidate->value))
+                    return candidate;
+                return current;
+            }
+
+            // first node not ordered before pValue, end() if none
+            Node *lowerBound(T const &pValue) const {
+                return lowerBound(pValue, _cmp);
+            }
+
+            template <class Key, class Less>
+            Node *lowerBound(Key const &pKey, Less const &pLess) const {
+                Node *candidate = _end;
+                for (Node *current = _root; current && !current->isNull; ) {
+                    if (pLess(current->value, pKey))
+                        current = current->right;
+                    else {
+                        candidate = current;
+                        current = current->left;
+                    }
+                }
+                return candidate;
+            }
+
+            // first node ordered after pValue, end() if none
+            Node *upperBound(T const &pValue) const {
+                return upperBound(pValue, _cmp);
+            }
+
+            template <class Key, class Less>
+            Node *upperBound(Key const &pKey, Less const &pLess) const {
+                Node *candidate = _end;
+                for (Node *current = _root; current && !current->isNull; ) {
+                    if (pLess(pKey, current->value)) {
+                        candidate = current;
+                        current = current->left;
+                    }
                     else
                         current = current->right;
                 }
+                return candidate;
             }
 
             size_t deleteNode(T const &pValue, Node *pToDelete=NULL) {
@@ -537,12 +1709,12 @@ namespace ft {
                     if (_root == node) {
                         _updateRoot(left);
                     }
-                    _alloc.destroy(node);
-                    _alloc.deallocate(node, 1);
-                    _alloc.destroy(right);
-                    _alloc.deallocate(right, 1);
-                    if (_root) // because we replace root with NULL (0x0) if left->isNull
+                    Node::release(node);
+                    Node::release(right);
+                    if (_root) { // because we replace root with NULL (0x0) if left->isNull
+                        _updatePath(parent);
                         _deleteFixup(left, original_color);
+                    }
                     _size--;
                     return 1;
                 }
@@ -556,10 +1728,9 @@ namespace ft {
                     if (_root == node) {
                         _updateRoot(right);
                     }
-                    _alloc.destroy(node);
-                    _alloc.deallocate(node, 1);
-                    _alloc.destroy(left);
-                    _alloc.deallocate(left, 1);
+                    Node::release(node);
+                    Node::release(left);
+                    _updatePath(right->parent);
                     _deleteFixup(right, original_color);
                     _size--;
                     return 1;
@@ -574,10 +1745,9 @@ namespace ft {
                     if (_root == node) {
                         _updateRoot(left);
                     }
-                    _alloc.destroy(node);
-                    _alloc.deallocate(node, 1);
-                    _alloc.destroy(right);
-                    _alloc.deallocate(right, 1);
+                    Node::release(node);
+                    Node::release(right);
+                    _updatePath(left->parent);
                     _deleteFixup(left, original_color);
                     _size--;
                     return 1;
@@ -592,10 +1762,9 @@ namespace ft {
                 }
                 Node *newChild = predecessor->left;
                 original_color = predecessor->color;
-                _alloc.destroy(predecessor->right);
-                _alloc.deallocate(predecessor->right, 1);
-                _alloc.destroy(predecessor);
-                _alloc.deallocate(predecessor, 1);
+                Node::release(predecessor->right);
+                Node::release(predecessor);
+                _updatePath(newChild->parent);
                 _deleteFixup(newChild, original_color);
                 _size--;
                 return 1;
@@ -633,7 +1802,7 @@ namespace ft {
                 return current ? current->parent : _end;
             }
 
-            size_t max_size() {
+            size_t max_size() const {
                 return _alloc.max_size();
             }
     };
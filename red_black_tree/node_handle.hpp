@@ -0,0 +1,125 @@
+#ifndef _NODE_HANDLE_HPP_INCLUDED_
+#define _NODE_HANDLE_HPP_INCLUDED_
+#include "common.hpp"
+
+namespace ft {
+    template <class T, class Compare, class Allocator>
+    class set;
+
+    template <class Key, class T, class Compare, class Allocator>
+    class map;
+
+    // owns a node extracted from a set or map until it is inserted into
+    // one again, or frees it. There is no move in C++98: copying a handle
+    // hands the node over and leaves the source empty, like auto_ptr
+    template <class Node>
+    class node_handle_base {
+        protected:
+            mutable Node *_node;
+
+            node_handle_base() : _node(NULL) {}
+
+            explicit node_handle_base(Node *pNode) : _node(pNode) {}
+
+            node_handle_base(node_handle_base const &src) : _node(src._release()) {}
+
+            ~node_handle_base() {
+                _destroy();
+            }
+
+            void _assign(node_handle_base const &src) {
+                if (&src == this)
+                    return ;
+                _destroy();
+                _node = src._release();
+            }
+
+            Node *_release() const {
+                Node *node = _node;
+                _node = NULL;
+                return node;
+            }
+
+            // a detached node carries a single leaf, as its right child
+            void _destroy() {
+                if (!_node)
+                    return ;
+                Node::release(_node->right);
+                Node::release(_node);
+                _node = NULL;
+            }
+
+        public:
+            bool empty() const {
+                return _node == NULL;
+            }
+
+            void swap(node_handle_base &x) {
+                Node *node = _node;
+                _node = x._node;
+                x._node = node;
+            }
+    };
+
+    template <class Node, class Value>
+    class set_node_handle : public node_handle_base<Node> {
+        private:
+            typedef node_handle_base<Node> base;
+
+            template <class, class, class>
+            friend class set;
+
+            explicit set_node_handle(Node *pNode) : base(pNode) {}
+
+        public:
+            typedef Value value_type;
+
+            set_node_handle() {}
+
+            set_node_handle(set_node_handle const &src) : base(src) {}
+
+            set_node_handle &operator=(set_node_handle const &src) {
+                this->_assign(src);
+                return *this;
+            }
+
+            value_type &value() const {
+                return this->_node->value;
+            }
+    };
+
+    template <class Node, class Key, class Mapped>
+    class map_node_handle : public node_handle_base<Node> {
+        private:
+            typedef node_handle_base<Node> base;
+
+            template <class, class, class, class>
+            friend class map;
+
+            explicit map_node_handle(Node *pNode) : base(pNode) {}
+
+        public:
+            typedef Key    key_type;
+            typedef Mapped mapped_type;
+
+            map_node_handle() {}
+
+            map_node_handle(map_node_handle const &src) : base(src) {}
+
+            map_node_handle &operator=(map_node_handle const &src) {
+                this->_assign(src);
+                return *this;
+            }
+
+            // the key may change while the node is out of any map
+            key_type &key() const {
+                return const_cast<key_type&>(this->_node->value.first);
+            }
+
+            mapped_type &mapped() const {
+                return this->_node->value.second;
+            }
+    };
+} // namespace ft
+
+#endif
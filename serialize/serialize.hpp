@@ -0,0 +1,341 @@
+#ifndef _SERIALIZE_HPP_INCLUDED_
+#define _SERIALIZE_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include "stack.hpp"
+#include "map.hpp"
+#include "set.hpp"
+
+// Binary checkpoints of containers holding plain data. A stream is a fixed
+// header followed by chunks (a uint32 element count and the raw elements),
+// terminated by an empty chunk, so neither side ever buffers more than one
+// chunk. Maps and sets are written in key order and rebuilt with
+// assign_sorted, which links a balanced tree in O(n) and only compares each
+// record with the one before it. Values are written in host byte order. A
+// stream that is cut short or corrupt throws and leaves the container as it
+// was.
+
+namespace ft {
+    // types whose bytes are the whole value, specialize it for your own
+    // plain structs to make them serializable
+    template <class T>
+    struct is_serializable
+        : public integral_constant<bool, is_integral<T>::value || is_floating_point<T>::value> {};
+
+    template <class T>
+    struct is_serializable<const T> : public is_serializable<T> {};
+
+    template <class T1, class T2>
+    struct is_serializable<pair<T1, T2> >
+        : public integral_constant<bool, is_serializable<T1>::value && is_serializable<T2>::value> {};
+
+    namespace detail {
+        static const size_t   serial_chunk_bytes = 1 << 20;
+        static const uint16_t serial_version = 1;
+
+        enum serial_kind {
+            serial_vector = 1,
+            serial_map = 2,
+            serial_set = 3,
+            serial_bit_vector = 4
+        };
+
+        struct serial_header {
+            char     magic[4];
+            uint16_t version;
+            uint16_t kind;
+            uint32_t element_size;
+            uint32_t reserved;
+            uint64_t count;
+        };
+
+        inline void serial_write(std::ostream &out, const void *data, size_t bytes) {
+            out.write(static_cast<const char*>(data), bytes);
+            if (!out)
+                throw std::runtime_error("serialize: write failed");
+        }
+
+        inline void serial_read(std::istream &in, void *data, size_t bytes) {
+            in.read(static_cast<char*>(data), bytes);
+            if ((size_t)in.gcount() != bytes)
+                throw std::runtime_error("deserialize: unexpected end of stream");
+        }
+
+        inline void write_header(std::ostream &out, serial_kind kind, size_t element_size, size_t count) {
+            serial_header header;
+            std::memcpy(header.magic, "ftsr", 4);
+            header.version = serial_version;
+            header.kind = kind;
+            header.element_size = element_size;
+            header.reserved = 0;
+            header.count = count;
+            serial_write(out, &header, sizeof(header));
+        }
+
+        inline size_t read_header(std::istream &in, serial_kind kind, size_t element_size) {
+            serial_header header;
+            serial_read(in, &header, sizeof(header));
+            if (std::memcmp(header.magic, "ftsr", 4) != 0 || header.version != serial_version
+                || header.kind != kind || header.element_size != element_size)
+                throw std::runtime_error("deserialize: bad header");
+            return header.count;
+        }
+
+        inline void write_chunk(std::ostream &out, const void *data, uint32_t count, size_t element_size) {
+            serial_write(out, &count, sizeof(count));
+            serial_write(out, data, count * element_size);
+        }
+
+        inline size_t chunk_capacity(size_t element_size) {
+            return element_size >= serial_chunk_bytes ? 1 : serial_chunk_bytes / element_size;
+        }
+
+        // writes the elements of an ordered range through a chunk buffer
+        template <class V, class Iterator>
+        void write_records(std::ostream &out, Iterator first, Iterator last) {
+            size_t   capacity = chunk_capacity(sizeof(V));
+            char     *buffer = static_cast<char*>(std::malloc(capacity * sizeof(V)));
+            uint32_t count = 0;
+            if (!buffer)
+                throw std::bad_alloc();
+            try {
+                for (; first != last; ++first) {
+                    std::memcpy(buffer + count * sizeof(V), &(*first), sizeof(V));
+                    if (++count == capacity) {
+                        write_chunk(out, buffer, count, sizeof(V));
+                        count = 0;
+                    }
+                }
+                if (count)
+                    write_chunk(out, buffer, count, sizeof(V));
+                write_chunk(out, buffer, 0, sizeof(V));
+            } catch (...) {
+                std::free(buffer);
+                throw;
+            }
+            std::free(buffer);
+        }
+
+        // pulls records back one chunk at a time
+        template <class V>
+        class record_reader {
+            private:
+                std::istream &_in;
+                char         *_buffer;
+                uint32_t     _count;
+                uint32_t     _index;
+
+                record_reader(record_reader const &);
+                record_reader &operator=(record_reader const &);
+
+            public:
+                explicit record_reader(std::istream &in) : _in(in), _count(0), _index(0) {
+                    _buffer = static_cast<char*>(std::malloc(chunk_capacity(sizeof(V)) * sizeof(V)));
+                    if (!_buffer)
+                        throw std::bad_alloc();
+                }
+
+                ~record_reader() {
+                    std::free(_buffer);
+                }
+
+                const V &current() {
+                    if (_index == _count) {
+                        serial_read(_in, &_count, sizeof(_count));
+                        if (_count == 0 || _count > chunk_capacity(sizeof(V)))
+                            throw std::runtime_error("deserialize: bad chunk");
+                        serial_read(_in, _buffer, _count * sizeof(V));
+                        _index = 0;
+                    }
+                    return *reinterpret_cast<const V*>(_buffer + _index * sizeof(V));
+                }
+
+                void advance() {
+                    _index++;
+                }
+
+                void finish() {
+                    uint32_t count;
+                    if (_index != _count)
+                        throw std::runtime_error("deserialize: trailing records");
+                    serial_read(_in, &count, sizeof(count));
+                    if (count != 0)
+                        throw std::runtime_error("deserialize: trailing records");
+                }
+        };
+
+        // input iterator over a record_reader, what assign_sorted consumes
+        template <class V>
+        class record_iterator : public iterator<input_iterator_tag, V> {
+            private:
+                record_reader<V> *_reader;
+
+            public:
+                explicit record_iterator(record_reader<V> &reader) : _reader(&reader) {}
+
+                const V &operator*() const {
+                    return _reader->current();
+                }
+
+                record_iterator &operator++() {
+                    _reader->advance();
+                    return *this;
+                }
+        };
+
+        // gives read access to stack::c
+        template <class T, class Container>
+        struct stack_access : public stack<T, Container> {
+            static Container &container(stack<T, Container> &s) {
+                return s.*(&stack_access::c);
+            }
+
+            static const Container &container(const stack<T, Container> &s) {
+                return s.*(&stack_access::c);
+            }
+        };
+    } // namespace detail
+
+    // vector: every chunk is written straight out of data()
+    template <class T, class Alloc, class Growth>
+    typename enable_if<is_serializable<T>::value>::type
+    serialize(std::ostream &out, const vector<T, Alloc, Growth> &v) {
+        size_t capacity = detail::chunk_capacity(sizeof(T));
+        detail::write_header(out, detail::serial_vector, sizeof(T), v.size());
+        for (size_t done = 0; done < v.size(); ) {
+            size_t count = v.size() - done < capacity ? v.size() - done : capacity;
+            detail::write_chunk(out, v.data() + done, count, sizeof(T));
+            done += count;
+        }
+        detail::write_chunk(out, v.data(), 0, sizeof(T));
+    }
+
+    // the header's count is only trusted as far as the chunks that
+    // actually arrive, the vector grows with them. It is built on the side
+    // and swapped in once the whole stream has been read
+    template <class T, class Alloc, class Growth>
+    typename enable_if<is_serializable<T>::value>::type
+    deserialize(std::istream &in, vector<T, Alloc, Growth> &v) {
+        size_t                   count = detail::read_header(in, detail::serial_vector, sizeof(T));
+        size_t                   capacity = detail::chunk_capacity(sizeof(T));
+        vector<T, Alloc, Growth> read(v.get_allocator());
+        size_t                   done = 0;
+        while (true) {
+            uint32_t chunk;
+            detail::serial_read(in, &chunk, sizeof(chunk));
+            if (chunk == 0)
+                break ;
+            if (chunk > capacity || chunk > count - done)
+                throw std::runtime_error("deserialize: bad chunk");
+            read.resize(done + chunk);
+            detail::serial_read(in, read.data() + done, chunk * sizeof(T));
+            done += chunk;
+        }
+        if (done != count)
+            throw std::runtime_error("deserialize: missing records");
+        v.swap(read);
+    }
+
+    // vector<bool>: the bit count in the header, then the packed words in
+    // chunks. Bits past size() are zero in the last word, a stream where
+    // they are not is corrupt
+    template <class Alloc, class Growth>
+    void serialize(std::ostream &out, const vector<bool, Alloc, Growth> &v) {
+        const detail::bit_word *words = detail::bit_access::word(v.begin());
+        size_t                 total = detail::bit_words(v.size());
+        size_t                 capacity = detail::chunk_capacity(sizeof(detail::bit_word));
+        detail::write_header(out, detail::serial_bit_vector, sizeof(detail::bit_word), v.size());
+        for (size_t done = 0; done < total; ) {
+            size_t count = total - done < capacity ? total - done : capacity;
+            detail::write_chunk(out, words + done, count, sizeof(detail::bit_word));
+            done += count;
+        }
+        detail::write_chunk(out, words, 0, sizeof(detail::bit_word));
+    }
+
+    template <class Alloc, class Growth>
+    void deserialize(std::istream &in, vector<bool, Alloc, Growth> &v) {
+        size_t                      count = detail::read_header(in, detail::serial_bit_vector,
+                                                                sizeof(detail::bit_word));
+        size_t                      total = count / detail::bit_word_bits + (count % detail::bit_word_bits != 0);
+        size_t                      capacity = detail::chunk_capacity(sizeof(detail::bit_word));
+        vector<bool, Alloc, Growth> read(v.get_allocator());
+        size_t                      done = 0;
+        while (true) {
+            uint32_t chunk;
+            detail::serial_read(in, &chunk, sizeof(chunk));
+            if (chunk == 0)
+                break ;
+            if (chunk > capacity || chunk > total - done)
+                throw std::runtime_error("deserialize: bad chunk");
+            done += chunk;
+            read.resize(done == total ? count : done * detail::bit_word_bits);
+            detail::serial_read(in, detail::bit_access::word(read.begin()) + done - chunk,
+                                chunk * sizeof(detail::bit_word));
+        }
+        if (done != total)
+            throw std::runtime_error("deserialize: missing records");
+        if (count % detail::bit_word_bits
+            && detail::bit_access::word(read.begin())[total - 1] & ~detail::bit_mask_below(count % detail::bit_word_bits))
+            throw std::runtime_error("deserialize: bad chunk");
+        v.swap(read);
+    }
+
+    // map and set: sorted records, rebuilt in O(n)
+    template <class Key, class T, class Compare, class Alloc>
+    typename enable_if<is_serializable<typename map<Key, T, Compare, Alloc>::value_type>::value>::type
+    serialize(std::ostream &out, const map<Key, T, Compare, Alloc> &m) {
+        typedef typename map<Key, T, Compare, Alloc>::value_type value_type;
+        detail::write_header(out, detail::serial_map, sizeof(value_type), m.size());
+        detail::write_records<value_type>(out, m.begin(), m.end());
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    typename enable_if<is_serializable<typename map<Key, T, Compare, Alloc>::value_type>::value>::type
+    deserialize(std::istream &in, map<Key, T, Compare, Alloc> &m) {
+        typedef typename map<Key, T, Compare, Alloc>::value_type value_type;
+        size_t                            count = detail::read_header(in, detail::serial_map, sizeof(value_type));
+        detail::record_reader<value_type> reader(in);
+        map<Key, T, Compare, Alloc>       read(m.key_comp(), m.get_allocator());
+        read.assign_sorted(detail::record_iterator<value_type>(reader), count);
+        reader.finish();
+        m.swap(read);
+    }
+
+    template <class T, class Compare, class Alloc>
+    typename enable_if<is_serializable<T>::value>::type
+    serialize(std::ostream &out, const set<T, Compare, Alloc> &s) {
+        detail::write_header(out, detail::serial_set, sizeof(T), s.size());
+        detail::write_records<T>(out, s.begin(), s.end());
+    }
+
+    template <class T, class Compare, class Alloc>
+    typename enable_if<is_serializable<T>::value>::type
+    deserialize(std::istream &in, set<T, Compare, Alloc> &s) {
+        size_t                   count = detail::read_header(in, detail::serial_set, sizeof(T));
+        detail::record_reader<T> reader(in);
+        set<T, Compare, Alloc>   read(s.key_comp(), s.get_allocator());
+        read.assign_sorted(detail::record_iterator<T>(reader), count);
+        reader.finish();
+        s.swap(read);
+    }
+
+    // stack: whatever its container writes
+    template <class T, class Container>
+    void serialize(std::ostream &out, const stack<T, Container> &s) {
+        serialize(out, detail::stack_access<T, Container>::container(s));
+    }
+
+    template <class T, class Container>
+    void deserialize(std::istream &in, stack<T, Container> &s) {
+        deserialize(in, detail::stack_access<T, Container>::container(s));
+    }
+} // namespace ft
+
+#endif
@@ -5,6 +5,7 @@
 #include "RedBlackTree.hpp"
 #include "utility.hpp"
 #include "RBT_Iterator.hpp"
+#include "node_handle.hpp"
 
 namespace ft {
     template <class T, class Compare = less<T>, class Allocator = std::allocator<T> >
@@ -15,6 +16,19 @@ namespace ft {
             Allocator                _alloc;
 
             typedef RedBlackTree<T, Compare>                       tree_type;
+
+            friend struct detail::tree_access<set>;
+
+            // looks up to tree_type::findGroupSize keys of first up at once
+            template <class InputIterator>
+            size_t _findGroup(InputIterator &first, InputIterator last, typename tree_type::Node **pNodes) const {
+                key_type keys[tree_type::findGroupSize];
+                size_t   n = 0;
+                for (; n < tree_type::findGroupSize && first != last; ++first)
+                    keys[n++] = *first;
+                _tree.findGroup(keys, pNodes, n, Compare());
+                return n;
+            }
         public:
             typedef T                                              key_type;
             typedef T                                              value_type;
@@ -31,6 +45,7 @@ namespace ft {
             typedef ft::reverse_iterator<iterator>                 reverse_iterator;
             typedef iterator_traits<iterator>                      difference_type;
             typedef size_t                                         size_type;
+            typedef set_node_handle<typename tree_type::Node, value_type> node_type;
 
             // constuctors
             explicit set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
@@ -127,22 +142,80 @@ namespace ft {
                 }
             }
 
+            // same result as insert(first, last), but the batch is sorted
+            // (radix sorted for integral keys) and goes into the tree in one
+            // pass instead of a descent per element. Worth it for large
+            // unsorted batches; returns the number of elements inserted
+            template <class InputIterator>
+            size_type bulk_insert(InputIterator first, InputIterator last) {
+                return _tree.insertBatch(first, last, detail::radix_key<T, Compare>());
+            }
+
             void erase(iterator position) {
                 _tree.deleteNode(position._ptr->value, position._ptr);
             }
 
             size_type erase(const key_type& k) {
-                typename tree_type::Node *node;
                 return _tree.deleteNode(k);
             }
 
             void erase(iterator first, iterator last) {
-                if (first == last)
-                    return ;
-                iterator tmp(first);
-                ++tmp;
-                erase(first);
-                erase(tmp, last);
+                _tree.eraseRange(first._ptr, last._ptr);
+            }
+
+            // node handles: extract cuts an element out without freeing it,
+            // insert links it back, here or into another set, and merge moves
+            // over every element whose key is missing here. None of them
+            // allocates or copies an element
+            node_type extract(iterator position) {
+                return node_type(_tree.extractNode(position._ptr));
+            }
+
+            node_type extract(const key_type& k) {
+                typename tree_type::Node *node = _tree.findNode(k);
+                if (!node || node->isNull)
+                    return node_type();
+                return node_type(_tree.extractNode(node));
+            }
+
+            // nh is emptied if its key was missing, otherwise it keeps the
+            // node and the element in the way is returned
+            pair<iterator, bool> insert(node_type& nh) {
+                if (nh.empty())
+                    return pair<iterator, bool>(end(), false);
+                pair<iterator, bool>      ret;
+                typename tree_type::Node *node;
+                node = _tree.insertDetached(nh._node, &(ret.second));
+                if (ret.second)
+                    nh._release();
+                ret.first = iterator(node);
+                return ret;
+            }
+
+            iterator insert(iterator position, node_type& nh) {
+                (void) position;
+                return insert(nh).first;
+            }
+
+            // elements whose key is already here stay in source
+            void merge(set& source) {
+                _tree.merge(source._tree);
+            }
+
+            // moves every element into one block of memory, in order, so
+            // that later scans and lookups are friendlier to the cache. The
+            // elements are copied once, iterators are invalidated. Returns
+            // the bytes of heap reclaimed
+            size_type compact() {
+                return _tree.compact();
+            }
+
+            // replaces the content with the n elements of first, which must be
+            // sorted by key_comp() without duplicates, in O(n). Throws
+            // invalid_argument if they are not and leaves the content as it was
+            template <class InputIterator>
+            void assign_sorted(InputIterator first, size_type n) {
+                _tree.buildSorted(first, n);
             }
 
             void swap (set& x) {
@@ -193,25 +266,39 @@ namespace ft {
                 return find(k) != end();
             }
 
-            iterator lower_bound(const value_type& k) const {
-                typename tree_type::Node *node;
-                node = _tree.findNode(k);
-                if (!node)
-                    return iterator(_tree.end());
-                if (node->isNull) {
-                    iterator it(node);
-                    return ++it;
+            // batched lookups: the keys of [first, last) are searched for in
+            // groups whose descents interleave (see RedBlackTree::findGroup).
+            // find_many writes an iterator for each key to out, in order,
+            // end() where it is missing; count_many counts the keys present
+            template <class InputIterator, class OutputIterator>
+            OutputIterator find_many(InputIterator first, InputIterator last, OutputIterator out) const {
+                typename tree_type::Node *nodes[tree_type::findGroupSize];
+                while (first != last) {
+                    size_t n = _findGroup(first, last, nodes);
+                    for (size_t i = 0; i < n; i++)
+                        *out++ = iterator(nodes[i] ? nodes[i] : _tree.end());
                 }
-                return iterator(node);
+                return out;
+            }
+
+            template <class InputIterator>
+            size_type count_many(InputIterator first, InputIterator last) const {
+                typename tree_type::Node *nodes[tree_type::findGroupSize];
+                size_type                count = 0;
+                while (first != last) {
+                    size_t n = _findGroup(first, last, nodes);
+                    for (size_t i = 0; i < n; i++)
+                        count += nodes[i] != NULL;
+                }
+                return count;
+            }
+
+            iterator lower_bound(const value_type& k) const {
+                return iterator(_tree.lowerBound(k));
             }
 
             iterator upper_bound(const value_type& k) const {
-                typename tree_type::Node *node;
-                node = _tree.findNode(k);
-                if (!node)
-                    return iterator(_tree.end());
-                iterator it(node);
-                return ++it;
+                return iterator(_tree.upperBound(k));
             }
 
             pair<iterator,iterator> equal_range(const value_type& k) const {
@@ -223,6 +310,38 @@ namespace ft {
                 return allocator_type(_alloc);
             }
     };
+
+    // set algebra in place, rhs is consumed: lhs becomes its union,
+    // intersection or difference with rhs and rhs is left empty, its nodes
+    // either moved into lhs or freed. No value is copied or allocated and
+    // where both hold a key lhs keeps its own element. O(m log(n / m + 1))
+    // for sizes m <= n. parallel_set_algebra.hpp adds overloads taking a
+    // thread_pool that combine disjoint subtrees in parallel.
+    template <class T, class Compare, class Alloc>
+    void merge_union(set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        access::tree(lhs).unionWith(access::tree(rhs));
+    }
+
+    template <class T, class Compare, class Alloc>
+    void retain_intersection(set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        access::tree(lhs).intersectWith(access::tree(rhs));
+    }
+
+    template <class T, class Compare, class Alloc>
+    void remove_difference(set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        access::tree(lhs).subtract(access::tree(rhs));
+    }
+
+    // erases every element pred holds for in one in-order sweep, then
+    // rebalances once. Returns how many went
+    template <class T, class Compare, class Alloc, class Predicate>
+    typename set<T, Compare, Alloc>::size_type erase_if(set<T, Compare, Alloc> &c, Predicate pred) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        return access::tree(c).eraseIf(pred);
+    }
 } // namespace ft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,432 @@
+#ifndef _SMALL_VECTOR_HPP_INCLUDED_
+#define _SMALL_VECTOR_HPP_INCLUDED_
+#include "common.hpp"
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "type_traits.hpp"
+#include "VectorIterator.hpp"
+
+namespace ft {
+    // vector that keeps its first N elements inside the object itself and
+    // only asks the allocator for memory once it grows past N
+    template <class T, size_t N, class Alloc = std::allocator<T> >
+    class small_vector {
+        private:
+            union _Storage {
+                char        bytes[N * sizeof(T)];
+                long double alignLongDouble; // only here to align bytes
+                long        alignLong;
+                void        *alignPtr;
+            };
+
+            T*       _arr;
+            size_t   _size;
+            size_t   _capacity;
+            Alloc    _alloc;
+            _Storage _inline;
+
+            T *_inlineData() {
+                return reinterpret_cast<T*>(_inline.bytes);
+            }
+
+            bool _isInline() const {
+                return _arr == reinterpret_cast<const T*>(_inline.bytes);
+            }
+
+            void _release() {
+                for (size_t i = 0; i < _size; i++)
+                    _alloc.destroy(&_arr[i]);
+                if (!_isInline())
+                    _alloc.deallocate(_arr, _capacity);
+                _arr = _inlineData();
+                _size = 0;
+                _capacity = N;
+            }
+
+            void _reAlloc(size_t new_capacity) {
+                if (new_capacity <= N && _isInline()) {
+                    _capacity = N;
+                    return ;
+                }
+                T *new_arr = new_capacity <= N ? _inlineData() : _alloc.allocate(new_capacity);
+
+                for (size_t i = 0; i < _size && i < new_capacity; i++) {
+                    _alloc.construct(&new_arr[i], _arr[i]);
+                    _alloc.destroy(&_arr[i]);
+                }
+                if (!_isInline())
+                    _alloc.deallocate(_arr, _capacity);
+                _arr = new_arr;
+                _capacity = new_capacity <= N ? N : new_capacity;
+            }
+
+            void _grow(size_t min_capacity) {
+                if (min_capacity > _capacity)
+                    _reAlloc(_capacity * 2 > min_capacity ? _capacity * 2 : min_capacity);
+            }
+
+            // opens a gap of n raw slots at pos, the gap is returned half
+            // constructed: slots before the old end still hold live objects
+            T *_openGap(size_t pos, size_t n) {
+                _grow(_size + n);
+                T *ptr = &_arr[pos];
+                T *old_end = &_arr[_size];
+                for (T *src = old_end; src != ptr; ) {
+                    --src;
+                    if (src + n >= old_end)
+                        _alloc.construct(src + n, *src);
+                    else
+                        src[n] = *src;
+                }
+                return ptr;
+            }
+
+            void _fillGap(T *ptr, size_t n, const T &val) {
+                T *old_end = &_arr[_size];
+                for (size_t i = 0; i < n; i++, ptr++) {
+                    if (ptr < old_end)
+                        *ptr = val;
+                    else
+                        _alloc.construct(ptr, val);
+                }
+            }
+
+            // (n, val) with two integers lands in the iterator overloads,
+            // these send it on to the fill versions
+            template <class Integer>
+            void _assignRange(Integer n, Integer val, true_type) {
+                assign(size_type(n), value_type(val));
+            }
+
+            template <class InputIterator>
+            void _assignRange(InputIterator first, InputIterator last, false_type) {
+                clear();
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+
+            template <class Integer>
+            void _insertRange(size_t pos, Integer n, Integer val, true_type) {
+                insert(begin() + pos, size_type(n), value_type(val));
+            }
+
+            template <class InputIterator>
+            void _insertRange(size_t pos, InputIterator first, InputIterator last, false_type) {
+                small_vector tmp(first, last); // also protects against ranges aliasing *this
+                if (tmp.empty())
+                    return ;
+                T *ptr = _openGap(pos, tmp._size);
+                T *old_end = &_arr[_size];
+                for (size_t i = 0; i < tmp._size; i++, ptr++) {
+                    if (ptr < old_end)
+                        *ptr = tmp._arr[i];
+                    else
+                        _alloc.construct(ptr, tmp._arr[i]);
+                }
+                _size += tmp._size;
+            }
+
+        public:
+            typedef T                                                   value_type;
+            typedef Alloc                                               allocator_type;
+            typedef typename allocator_type::reference                  reference;
+            typedef typename allocator_type::const_reference            const_reference;
+            typedef VectorIterator<value_type>                          iterator;
+            typedef const VectorIterator<value_type>                    const_iterator;
+            typedef ft::reverse_iterator<const_iterator>                const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                      reverse_iterator;
+            typedef typename iterator_traits<iterator>::difference_type difference_type;
+            typedef typename allocator_type::size_type                  size_type;
+
+            static const size_type inline_capacity = N;
+
+            // constructors
+            small_vector(const allocator_type& alloc = allocator_type())
+                : _arr(_inlineData()), _size(0), _capacity(N), _alloc(alloc) {}
+
+            small_vector(size_type n, const value_type &val = value_type(), \
+                        const allocator_type &alloc = allocator_type())
+                : _arr(_inlineData()), _size(0), _capacity(N), _alloc(alloc)
+            {
+                assign(n, val);
+            }
+
+            template <class InputIterator>
+            small_vector(InputIterator begin, InputIterator end, \
+                        const allocator_type& alloc = allocator_type())
+                : _arr(_inlineData()), _size(0), _capacity(N), _alloc(alloc)
+            {
+                _assignRange(begin, end, integral_constant<bool, is_integral<InputIterator>::value>());
+            }
+
+            small_vector(const small_vector& obj)
+                : _arr(_inlineData()), _size(0), _capacity(N), _alloc(obj._alloc)
+            {
+                _reAlloc(obj._size);
+                for (; _size < obj._size; _size++)
+                    _alloc.construct(&_arr[_size], obj._arr[_size]);
+            }
+
+            // destructor
+            ~small_vector() {
+                _release();
+            }
+
+            // equal operator
+            small_vector &operator=(const small_vector &rhs) {
+                if (this != &rhs)
+                    assign(rhs.begin(), rhs.end());
+                return *this;
+            }
+
+            // iterators
+            iterator begin() {
+                return iterator(_arr);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(_arr);
+            }
+
+            iterator end() {
+                return iterator(_arr + _size);
+            }
+
+            const_iterator end() const {
+                return const_iterator(_arr + _size);
+            }
+
+            reverse_iterator rbegin() {
+                return reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            reverse_iterator rend() {
+                return reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            size_type size() const {
+                return _size;
+            }
+
+            size_type max_size() const {
+                return _alloc.max_size();
+            }
+
+            void resize(size_type n, value_type val = value_type()) {
+                _grow(n);
+                for (size_t i = n; i < _size; i++) // if n < size
+                    _alloc.destroy(&_arr[i]);
+                for (size_t i = _size; i < n; i++) // if n > size
+                    _alloc.construct(&_arr[i], val);
+                _size = n;
+            }
+
+            size_type capacity() const {
+                return _capacity;
+            }
+
+            bool empty() const {
+                return _size == 0;
+            }
+
+            void reserve(size_type n) {
+                if (n <= _capacity)
+                    return ;
+                _reAlloc(n);
+            }
+
+            // true while the elements still live inside the object
+            bool is_inline() const {
+                return _isInline();
+            }
+
+            // element access
+            reference operator[] (size_type n) {
+                return _arr[n];
+            }
+
+            const_reference operator[] (size_type n) const {
+                return _arr[n];
+            }
+
+            reference at(size_type n) {
+                if (n >= _size) throw std::out_of_range("small_vector");
+                return _arr[n];
+            }
+
+            const_reference at(size_type n) const {
+                if (n >= _size) throw std::out_of_range("small_vector");
+                return _arr[n];
+            }
+
+            reference front() {
+                return _arr[0];
+            }
+
+            const_reference front() const {
+                return _arr[0];
+            }
+
+            reference back() {
+                return _arr[_size - 1];
+            }
+
+            const_reference back() const {
+                return _arr[_size - 1];
+            }
+
+            value_type* data() {
+                return _arr;
+            }
+
+            const value_type* data() const {
+                return _arr;
+            }
+
+            // modifiers
+            template <class InputIterator>
+            void assign(InputIterator first, InputIterator last) {
+                _assignRange(first, last, integral_constant<bool, is_integral<InputIterator>::value>());
+            }
+
+            void assign(size_type n, const value_type& val) {
+                clear();
+                reserve(n);
+                for (; _size < n; _size++)
+                    _alloc.construct(&_arr[_size], val);
+            }
+
+            void push_back(const value_type& val) {
+                if (_size >= _capacity) {
+                    value_type tmp(val); // val may live in the buffer we are about to free
+                    _grow(_size + 1);
+                    _alloc.construct(&_arr[_size], tmp);
+                }
+                else
+                    _alloc.construct(&_arr[_size], val);
+                _size++;
+            }
+
+            void pop_back() {
+                if (empty())
+                    return ;
+                _size--;
+                _alloc.destroy(&_arr[_size]);
+            }
+
+            iterator insert(iterator position, const value_type& val) {
+                size_t pos = position - begin();
+                insert(position, 1, val);
+                return iterator(&_arr[pos]);
+            }
+
+            void insert (iterator position, size_type n, const value_type& val) {
+                if (n == 0)
+                    return ;
+                size_t    pos = position - begin();
+                value_type tmp(val);
+                T *ptr = _openGap(pos, n);
+                _fillGap(ptr, n, tmp);
+                _size += n;
+            }
+
+            template <class InputIterator>
+            void insert (iterator position, InputIterator first, InputIterator last) {
+                _insertRange(position - begin(), first, last, integral_constant<bool, is_integral<InputIterator>::value>());
+            }
+
+            iterator erase(iterator position) {
+                return erase(position, position + 1);
+            }
+
+            iterator erase(iterator first, iterator last) {
+                size_t pos = first - begin();
+                size_t n = last - first;
+                if (n == 0)
+                    return first;
+                for (size_t i = pos + n; i < _size; i++)
+                    _arr[i - n] = _arr[i];
+                for (size_t i = _size - n; i < _size; i++)
+                    _alloc.destroy(&_arr[i]);
+                _size -= n;
+                return iterator(&_arr[pos]);
+            }
+
+            void swap(small_vector& x) {
+                if (!_isInline() && !x._isInline()) {
+                    T*     tmp_arr = x._arr;
+                    size_t tmp_capacity = x._capacity;
+                    x._arr = _arr;
+                    x._capacity = _capacity;
+                    _arr = tmp_arr;
+                    _capacity = tmp_capacity;
+                    size_t tmp_size = x._size;
+                    x._size = _size;
+                    _size = tmp_size;
+                    return ;
+                }
+                // at least one side lives in its inline buffer, elements have to move
+                small_vector tmp(*this);
+                *this = x;
+                x = tmp;
+            }
+
+            void clear() {
+                for (size_t i = 0; i < _size; i++)
+                    _alloc.destroy(&_arr[i]);
+                _size = 0;
+            }
+
+            allocator_type get_allocator() const {
+                return _alloc;
+            }
+    };
+
+    // relational operators
+    template <class T, size_t N, class Alloc>
+    bool operator==(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator!=(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator<(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator<=(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator>(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <class T, size_t N, class Alloc>
+    bool operator>=(const small_vector<T,N,Alloc>& lhs, const small_vector<T,N,Alloc>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    // swap
+    template <class T, size_t N, class Alloc>
+    void swap(small_vector<T,N,Alloc>& x, small_vector<T,N,Alloc>& y) {
+        x.swap(y);
+    }
+} // namespace ft
+
+#endif
@@ -0,0 +1,377 @@
+#ifndef _SNAPSHOT_HPP_INCLUDED_
+#define _SNAPSHOT_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "functional.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "VectorIterator.hpp"
+#include "map.hpp"
+#include "set.hpp"
+
+// Flat snapshots of maps and sets whose keys and values are trivially
+// copyable (no pointers, no owning members). The file is a page sized
+// header followed by the sorted records exactly as they sit in memory, so
+// opening it is a single mmap and every lookup is a binary search over the
+// mapping, pages are faulted in as they are touched.
+
+namespace ft {
+    struct snapshot_header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t record_size;
+        uint64_t count;
+        uint64_t data_offset;
+    };
+
+    namespace detail {
+        static const char     snapshot_magic[8] = {'f', 't', 's', 'n', 'a', 'p', '\0', '\0'};
+        static const uint32_t snapshot_version = 1;
+        static const uint64_t snapshot_data_offset = 4096;
+
+        // records are written and read back as raw bytes, anything owning
+        // memory or holding pointers would come back dangling
+        template <class T>
+        void check_snapshot_record() {
+            typedef char only_for_trivially_copyable_types
+                [is_trivially_copyable<T>::value ? 1 : -1];
+            (void)sizeof(only_for_trivially_copyable_types);
+        }
+
+        template <class Iterator>
+        void write_snapshot(const char *path, Iterator first, Iterator last, uint64_t count, uint32_t record_size) {
+            FILE *file = std::fopen(path, "wb");
+            if (!file)
+                throw std::runtime_error("snapshot: cannot create file");
+
+            char            page[snapshot_data_offset];
+            snapshot_header header;
+            std::memset(page, 0, sizeof(page));
+            std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+            header.version = snapshot_version;
+            header.record_size = record_size;
+            header.count = count;
+            header.data_offset = snapshot_data_offset;
+            std::memcpy(page, &header, sizeof(header));
+
+            bool ok = std::fwrite(page, sizeof(page), 1, file) == 1;
+            for (; ok && first != last; ++first)
+                ok = std::fwrite(&(*first), record_size, 1, file) == 1;
+            if (std::fclose(file) != 0 || !ok)
+                throw std::runtime_error("snapshot: write failed");
+        }
+
+        // read only mapping of a snapshot file, owns the mapping
+        class snapshot_file {
+            private:
+                void   *_base;
+                size_t _length;
+
+                snapshot_file(snapshot_file const &);
+                snapshot_file &operator=(snapshot_file const &);
+
+            public:
+                snapshot_file(const char *path, uint32_t record_size) : _base(NULL), _length(0) {
+                    int fd = open(path, O_RDONLY);
+                    if (fd < 0)
+                        throw std::runtime_error("snapshot: cannot open file");
+                    struct stat st;
+                    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(snapshot_header)) {
+                        close(fd);
+                        throw std::runtime_error("snapshot: truncated file");
+                    }
+                    _length = st.st_size;
+                    _base = mmap(NULL, _length, PROT_READ, MAP_SHARED, fd, 0);
+                    close(fd);
+                    if (_base == MAP_FAILED)
+                        throw std::runtime_error("snapshot: mmap failed");
+
+                    const snapshot_header *header = static_cast<const snapshot_header*>(_base);
+                    if (std::memcmp(header->magic, snapshot_magic, sizeof(header->magic)) != 0
+                        || header->version != snapshot_version
+                        || header->record_size != record_size
+                        || header->data_offset != snapshot_data_offset
+                        || header->data_offset > _length
+                        || header->count > (_length - header->data_offset) / record_size)
+                    {
+                        munmap(_base, _length);
+                        throw std::runtime_error("snapshot: bad header");
+                    }
+                }
+
+                ~snapshot_file() {
+                    munmap(_base, _length);
+                }
+
+                size_t size() const {
+                    return static_cast<const snapshot_header*>(_base)->count;
+                }
+
+                const void *data() const {
+                    const snapshot_header *header = static_cast<const snapshot_header*>(_base);
+                    return static_cast<const char*>(_base) + header->data_offset;
+                }
+        };
+    } // namespace detail
+
+    // writers
+    template <class Key, class T, class Compare, class Alloc>
+    void write_snapshot(const char *path, const map<Key, T, Compare, Alloc>& m) {
+        detail::check_snapshot_record<Key>();
+        detail::check_snapshot_record<T>();
+        detail::write_snapshot(path, m.begin(), m.end(), m.size(), \
+                               sizeof(typename map<Key, T, Compare, Alloc>::value_type));
+    }
+
+    template <class T, class Compare, class Alloc>
+    void write_snapshot(const char *path, const set<T, Compare, Alloc>& s) {
+        detail::check_snapshot_record<T>();
+        detail::write_snapshot(path, s.begin(), s.end(), s.size(), sizeof(T));
+    }
+
+    // read only map over a snapshot written from map<Key, T, Compare>
+    template <class Key, class T, class Compare = less<Key> >
+    class mapped_map {
+        public:
+            typedef Key                                          key_type;
+            typedef T                                            mapped_type;
+            typedef pair<const key_type, mapped_type>            value_type;
+            typedef Compare                                      key_compare;
+            typedef const value_type&                            reference;
+            typedef const value_type&                            const_reference;
+            typedef VectorIterator<const value_type>             iterator;
+            typedef VectorIterator<const value_type>             const_iterator;
+            typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>               reverse_iterator;
+            typedef ptrdiff_t                                    difference_type;
+            typedef size_t                                       size_type;
+
+        private:
+            detail::snapshot_file _file;
+            const value_type      *_first;
+            const value_type      *_last;
+            Compare               _cmp;
+
+            mapped_map(mapped_map const &);
+            mapped_map &operator=(mapped_map const &);
+
+        public:
+            explicit mapped_map(const char *path, const key_compare& comp = key_compare())
+                : _file(path, sizeof(value_type)), _cmp(comp)
+            {
+                detail::check_snapshot_record<Key>();
+                detail::check_snapshot_record<T>();
+                _first = static_cast<const value_type*>(_file.data());
+                _last = _first + _file.size();
+            }
+
+            // iterators
+            const_iterator begin() const {
+                return const_iterator(_first);
+            }
+
+            const_iterator end() const {
+                return const_iterator(_last);
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            bool empty() const {
+                return _first == _last;
+            }
+
+            size_type size() const {
+                return _last - _first;
+            }
+
+            // element access
+            const mapped_type& at(const key_type& k) const {
+                const_iterator it = find(k);
+                if (it == end())
+                    throw std::out_of_range("mapped_map::at");
+                return it->second;
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            // operations
+            const_iterator lower_bound(const key_type& k) const {
+                const value_type *first = _first;
+                size_type         count = _last - _first;
+                while (count > 0) {
+                    size_type half = count / 2;
+                    if (_cmp(first[half].first, k)) {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                        count = half;
+                }
+                return const_iterator(first);
+            }
+
+            const_iterator upper_bound(const key_type& k) const {
+                const value_type *first = _first;
+                size_type         count = _last - _first;
+                while (count > 0) {
+                    size_type half = count / 2;
+                    if (!_cmp(k, first[half].first)) {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                        count = half;
+                }
+                return const_iterator(first);
+            }
+
+            const_iterator find(const key_type& k) const {
+                const_iterator it = lower_bound(k);
+                if (it == end() || _cmp(k, it->first))
+                    return end();
+                return it;
+            }
+
+            size_type count(const key_type& k) const {
+                return find(k) != end();
+            }
+
+            pair<const_iterator,const_iterator> equal_range(const key_type& k) const {
+                return pair<const_iterator,const_iterator>(lower_bound(k), upper_bound(k));
+            }
+    };
+
+    // read only set over a snapshot written from set<T, Compare>
+    template <class T, class Compare = less<T> >
+    class mapped_set {
+        public:
+            typedef T                                            key_type;
+            typedef T                                            value_type;
+            typedef Compare                                      key_compare;
+            typedef Compare                                      value_compare;
+            typedef const value_type&                            reference;
+            typedef const value_type&                            const_reference;
+            typedef VectorIterator<const value_type>             iterator;
+            typedef VectorIterator<const value_type>             const_iterator;
+            typedef ft::reverse_iterator<const_iterator>         const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>               reverse_iterator;
+            typedef ptrdiff_t                                    difference_type;
+            typedef size_t                                       size_type;
+
+        private:
+            detail::snapshot_file _file;
+            const value_type      *_first;
+            const value_type      *_last;
+            Compare               _cmp;
+
+            mapped_set(mapped_set const &);
+            mapped_set &operator=(mapped_set const &);
+
+        public:
+            explicit mapped_set(const char *path, const key_compare& comp = key_compare())
+                : _file(path, sizeof(value_type)), _cmp(comp)
+            {
+                detail::check_snapshot_record<T>();
+                _first = static_cast<const value_type*>(_file.data());
+                _last = _first + _file.size();
+            }
+
+            // iterators
+            const_iterator begin() const {
+                return const_iterator(_first);
+            }
+
+            const_iterator end() const {
+                return const_iterator(_last);
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            bool empty() const {
+                return _first == _last;
+            }
+
+            size_type size() const {
+                return _last - _first;
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            value_compare value_comp() const {
+                return _cmp;
+            }
+
+            // operations
+            const_iterator lower_bound(const value_type& k) const {
+                const value_type *first = _first;
+                size_type         count = _last - _first;
+                while (count > 0) {
+                    size_type half = count / 2;
+                    if (_cmp(first[half], k)) {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                        count = half;
+                }
+                return const_iterator(first);
+            }
+
+            const_iterator upper_bound(const value_type& k) const {
+                const value_type *first = _first;
+                size_type         count = _last - _first;
+                while (count > 0) {
+                    size_type half = count / 2;
+                    if (!_cmp(k, first[half])) {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                        count = half;
+                }
+                return const_iterator(first);
+            }
+
+            const_iterator find(const value_type& k) const {
+                const_iterator it = lower_bound(k);
+                if (it == end() || _cmp(k, *it))
+                    return end();
+                return it;
+            }
+
+            size_type count(const value_type& k) const {
+                return find(k) != end();
+            }
+
+            pair<const_iterator,const_iterator> equal_range(const value_type& k) const {
+                return pair<const_iterator,const_iterator>(lower_bound(k), upper_bound(k));
+            }
+    };
+} // namespace ft
+
+#endif
@@ -0,0 +1,405 @@
+#ifndef _SPLIT_MAP_HPP_INCLUDED_
+#define _SPLIT_MAP_HPP_INCLUDED_
+#include "common.hpp"
+#include "functional.hpp"
+#include "RedBlackTree.hpp"
+#include "utility.hpp"
+#include "RBT_Iterator.hpp"
+#include "vector.hpp"
+
+namespace ft {
+    namespace detail {
+        // slots for values, allocated slabSize at a time and reused once
+        // given back. The caller constructs and destroys the values
+        template <class Value, class Allocator>
+        class cold_slab {
+            private:
+                typedef typename Allocator::pointer pointer;
+
+                Allocator       _alloc;
+                vector<pointer> _slabs;
+                vector<pointer> _free;
+
+                cold_slab(cold_slab const &);
+                cold_slab &operator=(cold_slab const &);
+
+            public:
+                static const size_t slabSize = 64;
+
+                explicit cold_slab(Allocator const &pAlloc) : _alloc(pAlloc) {}
+
+                ~cold_slab() {
+                    clear();
+                }
+
+                pointer take() {
+                    if (_free.empty()) {
+                        _slabs.push_back(_alloc.allocate(slabSize));
+                        for (size_t i = slabSize; i > 0; i--)
+                            _free.push_back(_slabs.back() + i - 1);
+                    }
+                    pointer slot = _free.back();
+                    _free.pop_back();
+                    return slot;
+                }
+
+                void give(pointer pSlot) {
+                    _free.push_back(pSlot);
+                }
+
+                // every slot must be empty
+                void clear() {
+                    for (size_t i = 0; i < _slabs.size(); i++)
+                        _alloc.deallocate(_slabs[i], slabSize);
+                    _slabs.clear();
+                    _free.clear();
+                }
+
+                void swap(cold_slab &x) {
+                    _slabs.swap(x._slabs);
+                    _free.swap(x._free);
+                    Allocator alloc(_alloc);
+                    _alloc = x._alloc;
+                    x._alloc = alloc;
+                }
+        };
+    } // namespace detail
+
+    // walks the hot tree and hands out the cold values it points to
+    template <class Value, class Hot, class HotComp>
+    class SplitMapIterator : public iterator<bidirectional_iterator_tag, Value> {
+        public:
+            typedef Value                      value_type;
+            typedef ptrdiff_t                  difference_type;
+            typedef Value*                     pointer;
+            typedef Value&                     reference;
+            typedef bidirectional_iterator_tag iterator_category;
+
+        private:
+            RBT_Iterator<Hot, HotComp> _it;
+
+        public:
+            SplitMapIterator() {}
+
+            explicit SplitMapIterator(typename RedBlackTree<Hot, HotComp>::Node *pNode) : _it(pNode) {}
+
+            bool operator==(SplitMapIterator const &rhs) const {
+                return _it == rhs._it;
+            }
+
+            bool operator!=(SplitMapIterator const &rhs) const {
+                return _it != rhs._it;
+            }
+
+            reference operator*() const {
+                return *_it->second;
+            }
+
+            pointer operator->() const {
+                return _it->second;
+            }
+
+            SplitMapIterator &operator++() {
+                ++_it;
+                return *this;
+            }
+
+            SplitMapIterator operator++(int) {
+                SplitMapIterator tmp(*this);
+                ++_it;
+                return tmp;
+            }
+
+            SplitMapIterator &operator--() {
+                --_it;
+                return *this;
+            }
+
+            SplitMapIterator operator--(int) {
+                SplitMapIterator tmp(*this);
+                --_it;
+                return tmp;
+            }
+
+            template<class Key, class X, class Compare, class Allocator>
+            friend class split_map;
+    };
+
+    // map whose tree holds only the keys, each with a pointer to its
+    // element, while the elements live out of line in slabs. A lookup
+    // touches key-sized nodes all the way down and the element only once
+    // found, so big mapped types no longer crowd the nodes out of the
+    // cache. Same interface and iterator semantics as map, at the cost of
+    // one extra indirection per element reached and the key stored twice
+    template<class Key, class T, class Compare = less<Key>,
+          class Allocator = std::allocator<pair<const Key, T> > >
+    class split_map {
+        private:
+            // the hot half: a key and where its element lives
+            typedef pair<const Key, pair<const Key, T>*> hot_type;
+
+            class HotComp {
+                private:
+                    Compare _cmp;
+                public:
+                    HotComp() : _cmp(Compare()) {}
+                    bool operator()(const hot_type &lhs, const hot_type &rhs) const {
+                        return _cmp(lhs.first, rhs.first);
+                    }
+            };
+
+            class KeyComp {
+                private:
+                    Compare _cmp;
+                public:
+                    KeyComp() : _cmp(Compare()) {}
+                    bool operator()(const Key &lhs, const hot_type &rhs) const {
+                        return _cmp(lhs, rhs.first);
+                    }
+                    bool operator()(const hot_type &lhs, const Key &rhs) const {
+                        return _cmp(lhs.first, rhs);
+                    }
+            };
+
+            typedef RedBlackTree<hot_type, HotComp>                  tree_type;
+            typedef typename tree_type::Node                         tree_node;
+            typedef detail::cold_slab<pair<const Key, T>, Allocator> cold_type;
+
+            tree_type _tree;
+            cold_type _cold;
+            Compare   _cmp;
+            Allocator _alloc;
+
+            // the element of a node just inserted; the node is taken out
+            // again if copying pValue throws
+            pair<const Key, T> *_coldFor(tree_node *pNode, pair<const Key, T> const &pValue) {
+                pair<const Key, T> *cold = _cold.take();
+                try {
+                    _alloc.construct(cold, pValue);
+                } catch (...) {
+                    _cold.give(cold);
+                    _tree.deleteNode(pNode->value, pNode);
+                    throw;
+                }
+                return cold;
+            }
+
+            tree_node *_findNode(const Key &k) const {
+                tree_node *node = _tree.findNode(k, KeyComp());
+                return node && !node->isNull ? node : NULL;
+            }
+
+        public:
+            // member types
+            typedef Key                                            key_type;
+            typedef T                                              mapped_type;
+            typedef pair<const key_type, mapped_type>              value_type;
+            typedef Compare                                        key_compare;
+            typedef Allocator                                      allocator_type;
+            typedef typename allocator_type::reference             reference;
+            typedef typename allocator_type::const_reference       const_reference;
+            typedef typename allocator_type::pointer               pointer;
+            typedef typename allocator_type::const_pointer         const_pointer;
+            typedef SplitMapIterator<value_type, hot_type, HotComp>       iterator;
+            typedef const SplitMapIterator<value_type, hot_type, HotComp> const_iterator;
+            typedef ft::reverse_iterator<const_iterator>           const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                 reverse_iterator;
+            typedef ptrdiff_t                                      difference_type;
+            typedef size_t                                         size_type;
+
+            class value_compare {
+                private:
+                    Compare _cmp;
+                public:
+                    value_compare() : _cmp(Compare()) {}
+                    bool operator()(const value_type &lhs, const value_type &rhs) const {
+                        return _cmp(lhs.first, rhs.first);
+                    }
+            };
+
+            // constuctors
+            explicit split_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _tree(), _cold(alloc), _cmp(comp), _alloc(alloc) {}
+
+            template <class InputIterator>
+            split_map(InputIterator first, InputIterator last, \
+                const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _tree(), _cold(alloc), _cmp(comp), _alloc(alloc)
+            {
+                insert(first, last);
+            }
+
+            split_map(const split_map& x) : _tree(), _cold(x._alloc), _cmp(x._cmp), _alloc(x._alloc) {
+                insert(x.begin(), x.end());
+            }
+
+            ~split_map() {
+                clear();
+            }
+
+            split_map& operator= (const split_map& x) {
+                if (&x == this)
+                    return *this;
+                clear();
+                insert(x.begin(), x.end());
+                return *this;
+            }
+
+            // iterators
+            iterator begin() const {
+                return iterator(_tree.size() == 0 ? _tree.end() : _tree.min());
+            }
+
+            iterator end() const {
+                return iterator(_tree.end());
+            }
+
+            reverse_iterator rbegin() const {
+                return reverse_iterator(end());
+            }
+
+            reverse_iterator rend() const {
+                return reverse_iterator(begin());
+            }
+
+            // capacity
+            bool empty() const {
+                return size() == 0;
+            }
+
+            size_type size() const {
+                return _tree.size();
+            }
+
+            size_type max_size() const {
+                return _tree.max_size();
+            }
+
+            // the mapped value is only made when k is missing
+            mapped_type& operator[] (const key_type& k) {
+                bool      inserted;
+                tree_node *node = _tree.insertNode(hot_type(k, NULL), &inserted);
+                if (inserted)
+                    node->value.second = _coldFor(node, value_type(k, mapped_type()));
+                return node->value.second->second;
+            }
+
+            mapped_type& at(const key_type& k) {
+                tree_node *node = _findNode(k);
+                if (!node)
+                    throw std::out_of_range("split_map::at");
+                return node->value.second->second;
+            }
+
+            const mapped_type& at(const key_type& k) const {
+                tree_node *node = _findNode(k);
+                if (!node)
+                    throw std::out_of_range("split_map::at");
+                return node->value.second->second;
+            }
+
+            // modifiers
+            pair<iterator, bool> insert(const value_type& val) {
+                pair<iterator, bool> ret;
+                tree_node            *node = _tree.insertNode(hot_type(val.first, NULL), &ret.second);
+                if (ret.second)
+                    node->value.second = _coldFor(node, val);
+                ret.first = iterator(node);
+                return ret;
+            }
+
+            iterator insert(iterator position, const value_type& val) {
+                (void) position;
+                return insert(val).first;
+            }
+
+            template <class InputIterator>
+            void insert(InputIterator first, InputIterator last) {
+                for (; first != last; ++first)
+                    insert(*first);
+            }
+
+            void erase(iterator position) {
+                tree_node  *node = position._it._ptr;
+                value_type *cold = node->value.second;
+                _tree.deleteNode(node->value, node);
+                _alloc.destroy(cold);
+                _cold.give(cold);
+            }
+
+            size_type erase(const key_type& k) {
+                tree_node *node = _findNode(k);
+                if (!node)
+                    return 0;
+                erase(iterator(node));
+                return 1;
+            }
+
+            void erase(iterator first, iterator last) {
+                for (iterator it = first; it != last; ++it) {
+                    _alloc.destroy(&*it);
+                    _cold.give(&*it);
+                }
+                _tree.eraseRange(first._it._ptr, last._it._ptr);
+            }
+
+            void swap(split_map& x) {
+                tree_type tmp(x._tree);
+                x._tree = _tree;
+                _tree = tmp;
+                _cold.swap(x._cold);
+
+                Compare   cmp(x._cmp);
+                Allocator alloc(x._alloc);
+                x._cmp = _cmp;
+                x._alloc = _alloc;
+                _cmp = cmp;
+                _alloc = alloc;
+            }
+
+            void clear() {
+                for (iterator it = begin(); it != end(); ++it)
+                    _alloc.destroy(&*it);
+                _tree.deleteTree();
+                _cold.clear();
+            }
+
+            // observers
+            key_compare key_comp() const {
+                return _cmp;
+            }
+
+            value_compare value_comp() const {
+                return value_compare();
+            }
+
+            // operations
+            iterator find(const key_type& k) const {
+                tree_node *node = _findNode(k);
+                return node ? iterator(node) : end();
+            }
+
+            size_type count(const key_type& k) const {
+                return _findNode(k) != NULL;
+            }
+
+            iterator lower_bound(const key_type& k) const {
+                return iterator(_tree.lowerBound(k, KeyComp()));
+            }
+
+            iterator upper_bound(const key_type& k) const {
+                return iterator(_tree.upperBound(k, KeyComp()));
+            }
+
+            pair<iterator, iterator> equal_range(const key_type& k) const {
+                return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+            }
+
+            // allocator
+            allocator_type get_allocator() const {
+                return allocator_type(_alloc);
+            }
+    };
+} // namespace ft
+
+#endif
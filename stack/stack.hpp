@@ -9,9 +9,11 @@ namespace ft {
         protected:
             Container c;
         public:
-            typedef Container                          container_type;
-            typedef T                                  value_type;
-            typedef typename container_type::size_type size_type;
+            typedef Container                                container_type;
+            typedef T                                        value_type;
+            typedef typename container_type::size_type       size_type;
+            typedef typename container_type::reference       reference;
+            typedef typename container_type::const_reference const_reference;
 
             explicit stack(const container_type& ctnr = container_type()) : c(ctnr) {}
             
@@ -23,11 +25,11 @@ namespace ft {
                 return c.size();
             }
 
-            value_type& top() {
+            reference top() {
                 return c.back();
             }
             
-            const value_type& top() const {
+            const_reference top() const {
                 return c.back();
             }
 
@@ -0,0 +1,59 @@
+#ifndef _PARALLEL_SET_ALGEBRA_HPP_INCLUDED_
+#define _PARALLEL_SET_ALGEBRA_HPP_INCLUDED_
+#include "common.hpp"
+#include "thread_pool.hpp"
+#include "map.hpp"
+#include "set.hpp"
+
+// merge_union, retain_intersection and remove_difference on a thread_pool:
+// same result as the overloads in map.hpp and set.hpp, rhs is consumed the
+// same way, but disjoint subtrees are split off and combined in parallel.
+// Kept apart so that map and set do not pull in pthreads.
+
+namespace ft {
+    // map
+    template <class Key, class T, class Compare, class Alloc>
+    void merge_union(thread_pool &pool, map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).unionWith(access::tree(rhs), invoke, invoke.forks());
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    void retain_intersection(thread_pool &pool, map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).intersectWith(access::tree(rhs), invoke, invoke.forks());
+    }
+
+    template <class Key, class T, class Compare, class Alloc>
+    void remove_difference(thread_pool &pool, map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<map<Key, T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).subtract(access::tree(rhs), invoke, invoke.forks());
+    }
+
+    // set
+    template <class T, class Compare, class Alloc>
+    void merge_union(thread_pool &pool, set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).unionWith(access::tree(rhs), invoke, invoke.forks());
+    }
+
+    template <class T, class Compare, class Alloc>
+    void retain_intersection(thread_pool &pool, set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).intersectWith(access::tree(rhs), invoke, invoke.forks());
+    }
+
+    template <class T, class Compare, class Alloc>
+    void remove_difference(thread_pool &pool, set<T, Compare, Alloc> &lhs, set<T, Compare, Alloc> &rhs) {
+        typedef detail::tree_access<set<T, Compare, Alloc> > access;
+        pool_invoke invoke(pool);
+        access::tree(lhs).subtract(access::tree(rhs), invoke, invoke.forks());
+    }
+} // namespace ft
+
+#endif
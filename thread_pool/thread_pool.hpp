@@ -0,0 +1,505 @@
+#ifndef _THREAD_POOL_HPP_INCLUDED_
+#define _THREAD_POOL_HPP_INCLUDED_
+#include "common.hpp"
+#include <exception>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace ft {
+    namespace detail {
+        // a unit of work. Tasks live on the stack of whoever forked them
+        // and are only referenced until done is set.
+        struct pool_task {
+            void (*run)(pool_task *);
+            int  done;
+            bool external; // someone outside the pool sleeps on it
+
+            explicit pool_task(void (*pRun)(pool_task *)) : run(pRun), done(0), external(false) {}
+        };
+
+        template <class Function>
+        struct function_task : public pool_task {
+            Function &f;
+
+            explicit function_task(Function &pF) : pool_task(&_run), f(pF) {}
+
+            static void _run(pool_task *t) {
+                try {
+                    static_cast<function_task*>(t)->f();
+                } catch (...) {
+                    std::terminate();
+                }
+            }
+        };
+
+        // Chase-Lev deque: the owning worker pushes and pops at the bottom
+        // without contention, thieves take from the top with one CAS. The
+        // ring doubles when full, replaced rings are kept until the deque
+        // dies since a thief may still be reading one.
+        class work_deque {
+            private:
+                struct _Ring {
+                    long      mask;
+                    pool_task **slots;
+                };
+
+                long          _top;
+                char          _pad[64];
+                long          _bottom;
+                _Ring         *_ring;
+                vector<_Ring*> _rings;
+
+                work_deque(work_deque const &);
+                work_deque &operator=(work_deque const &);
+
+                static _Ring *_newRing(long capacity) {
+                    _Ring *ring = new _Ring;
+                    ring->mask = capacity - 1;
+                    ring->slots = new pool_task*[capacity];
+                    return ring;
+                }
+
+                void _grow(long top, long bottom) {
+                    _Ring *old = _ring;
+                    _Ring *ring = _newRing(2 * (old->mask + 1));
+                    for (long i = top; i < bottom; i++)
+                        ring->slots[i & ring->mask] = old->slots[i & old->mask];
+                    _rings.push_back(ring);
+                    __atomic_store_n(&_ring, ring, __ATOMIC_RELEASE);
+                }
+
+            public:
+                work_deque() : _top(0), _bottom(0) {
+                    _ring = _newRing(256);
+                    _rings.push_back(_ring);
+                }
+
+                ~work_deque() {
+                    for (size_t i = 0; i < _rings.size(); i++) {
+                        delete[] _rings[i]->slots;
+                        delete _rings[i];
+                    }
+                }
+
+                // owner only
+                void push(pool_task *task) {
+                    long bottom = __atomic_load_n(&_bottom, __ATOMIC_RELAXED);
+                    long top = __atomic_load_n(&_top, __ATOMIC_ACQUIRE);
+                    if (bottom - top > _ring->mask)
+                        _grow(top, bottom);
+                    __atomic_store_n(&_ring->slots[bottom & _ring->mask], task, __ATOMIC_RELAXED);
+                    __atomic_store_n(&_bottom, bottom + 1, __ATOMIC_RELEASE);
+                }
+
+                // owner only, newest task first
+                pool_task *pop() {
+                    long bottom = __atomic_load_n(&_bottom, __ATOMIC_RELAXED) - 1;
+                    __atomic_store_n(&_bottom, bottom, __ATOMIC_RELAXED);
+                    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                    long top = __atomic_load_n(&_top, __ATOMIC_RELAXED);
+                    if (top > bottom) {
+                        __atomic_store_n(&_bottom, bottom + 1, __ATOMIC_RELAXED);
+                        return NULL;
+                    }
+                    pool_task *task = __atomic_load_n(&_ring->slots[bottom & _ring->mask], __ATOMIC_RELAXED);
+                    if (top == bottom) {
+                        // last one, race the thieves for it
+                        if (!__atomic_compare_exchange_n(&_top, &top, top + 1, false,
+                                                         __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                            task = NULL;
+                        __atomic_store_n(&_bottom, bottom + 1, __ATOMIC_RELAXED);
+                    }
+                    return task;
+                }
+
+                // any thread, oldest task first
+                pool_task *steal() {
+                    long top = __atomic_load_n(&_top, __ATOMIC_ACQUIRE);
+                    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                    long bottom = __atomic_load_n(&_bottom, __ATOMIC_ACQUIRE);
+                    if (top >= bottom)
+                        return NULL;
+                    _Ring     *ring = __atomic_load_n(&_ring, __ATOMIC_ACQUIRE);
+                    pool_task *task = __atomic_load_n(&ring->slots[top & ring->mask], __ATOMIC_RELAXED);
+                    if (!__atomic_compare_exchange_n(&_top, &top, top + 1, false,
+                                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                        return NULL;
+                    return task;
+                }
+        };
+    } // namespace detail
+
+    // fork/join pool: every worker owns a deque, forks push onto the
+    // forking worker's deque and idle workers steal from the other end, so
+    // big pieces of work move between threads and small ones stay where
+    // their data is hot. A thread waiting for a forked task keeps running
+    // other tasks meanwhile. Work coming from outside the pool goes through
+    // a shared queue and the caller sleeps until it is done.
+    // An exception escaping a task calls std::terminate.
+    class thread_pool {
+        private:
+            struct _Worker {
+                char              padBefore[64];
+                thread_pool       *pool;
+                pthread_t         thread;
+                detail::work_deque deque;
+                uint64_t          rng;
+                char              padAfter[64];
+            };
+
+            _Worker                   *_workers;
+            size_t                    _count;
+            bool                      _stop;
+            int                       _sleepers;
+            pthread_mutex_t           _sleepLock;
+            pthread_cond_t            _sleepCond;
+            pthread_mutex_t           _doneLock;
+            pthread_cond_t            _doneCond;
+            pthread_mutex_t           _injectLock;
+            vector<detail::pool_task*> _injected;
+            size_t                    _injectedCount;
+
+            thread_pool(thread_pool const &);
+            thread_pool &operator=(thread_pool const &);
+
+            static _Worker *&_current() {
+                static __thread _Worker *current = NULL;
+                return current;
+            }
+
+            _Worker *_self() const {
+                _Worker *worker = _current();
+                return worker && worker->pool == this ? worker : NULL;
+            }
+
+            void _notify() {
+                __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                if (__atomic_load_n(&_sleepers, __ATOMIC_RELAXED)) {
+                    pthread_mutex_lock(&_sleepLock);
+                    pthread_cond_signal(&_sleepCond);
+                    pthread_mutex_unlock(&_sleepLock);
+                }
+            }
+
+            void _execute(detail::pool_task *task) {
+                bool external = task->external;
+                task->run(task);
+                if (!external) {
+                    __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+                    return ;
+                }
+                pthread_mutex_lock(&_doneLock);
+                __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+                pthread_cond_broadcast(&_doneCond);
+                pthread_mutex_unlock(&_doneLock);
+            }
+
+            detail::pool_task *_steal(_Worker *self) {
+                self->rng ^= self->rng << 13;
+                self->rng ^= self->rng >> 7;
+                self->rng ^= self->rng << 17;
+                size_t start = self->rng % _count;
+                for (size_t i = 0; i < _count; i++) {
+                    _Worker *victim = &_workers[(start + i) % _count];
+                    if (victim == self)
+                        continue;
+                    detail::pool_task *task = victim->deque.steal();
+                    if (task)
+                        return task;
+                }
+                return NULL;
+            }
+
+            detail::pool_task *_takeInjected() {
+                if (!__atomic_load_n(&_injectedCount, __ATOMIC_ACQUIRE))
+                    return NULL;
+                detail::pool_task *task = NULL;
+                pthread_mutex_lock(&_injectLock);
+                if (!_injected.empty()) {
+                    task = _injected.back();
+                    _injected.pop_back();
+                    __atomic_store_n(&_injectedCount, _injected.size(), __ATOMIC_RELEASE);
+                }
+                pthread_mutex_unlock(&_injectLock);
+                return task;
+            }
+
+            detail::pool_task *_findWork(_Worker *self) {
+                detail::pool_task *task = self->deque.pop();
+                if (!task)
+                    task = _takeInjected();
+                if (!task)
+                    task = _steal(self);
+                return task;
+            }
+
+            static void *_main(void *arg) {
+                _Worker     *self = static_cast<_Worker*>(arg);
+                thread_pool *pool = self->pool;
+                _current() = self;
+                while (true) {
+                    detail::pool_task *task = pool->_findWork(self);
+                    if (task) {
+                        pool->_execute(task);
+                        continue;
+                    }
+                    pthread_mutex_lock(&pool->_sleepLock);
+                    __atomic_add_fetch(&pool->_sleepers, 1, __ATOMIC_SEQ_CST);
+                    if (!pool->_stop && !(task = pool->_findWork(self)))
+                        pthread_cond_wait(&pool->_sleepCond, &pool->_sleepLock);
+                    __atomic_sub_fetch(&pool->_sleepers, 1, __ATOMIC_SEQ_CST);
+                    bool stop = pool->_stop;
+                    pthread_mutex_unlock(&pool->_sleepLock);
+                    if (task)
+                        pool->_execute(task);
+                    else if (stop)
+                        break ;
+                }
+                return NULL;
+            }
+
+            // runs other tasks until task is done
+            void _join(_Worker *self, detail::pool_task *task) {
+                while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE)) {
+                    detail::pool_task *other = self->deque.pop();
+                    if (!other)
+                        other = _steal(self);
+                    if (other)
+                        _execute(other);
+                    else
+                        sched_yield();
+                }
+            }
+
+            // from outside the pool: queue the task and sleep until it ran
+            void _submitAndWait(detail::pool_task *task) {
+                task->external = true;
+                pthread_mutex_lock(&_injectLock);
+                _injected.push_back(task);
+                __atomic_store_n(&_injectedCount, _injected.size(), __ATOMIC_RELEASE);
+                pthread_mutex_unlock(&_injectLock);
+                _notify();
+                pthread_mutex_lock(&_doneLock);
+                while (!__atomic_load_n(&task->done, __ATOMIC_ACQUIRE))
+                    pthread_cond_wait(&_doneCond, &_doneLock);
+                pthread_mutex_unlock(&_doneLock);
+            }
+
+            // wakes and joins the first pStarted workers, the others never
+            // ran, then frees what the constructor set up
+            void _shutdown(size_t pStarted) {
+                pthread_mutex_lock(&_sleepLock);
+                _stop = true;
+                pthread_cond_broadcast(&_sleepCond);
+                pthread_mutex_unlock(&_sleepLock);
+                for (size_t i = 0; i < pStarted; i++)
+                    pthread_join(_workers[i].thread, NULL);
+                delete[] _workers;
+                pthread_mutex_destroy(&_injectLock);
+                pthread_cond_destroy(&_doneCond);
+                pthread_mutex_destroy(&_doneLock);
+                pthread_cond_destroy(&_sleepCond);
+                pthread_mutex_destroy(&_sleepLock);
+            }
+
+            template <class Function1, class Function2>
+            struct _Invoke {
+                Function1   &f;
+                Function2   &g;
+                thread_pool *pool;
+
+                _Invoke(Function1 &pF, Function2 &pG, thread_pool *pPool) : f(pF), g(pG), pool(pPool) {}
+
+                void operator()() {
+                    pool->invoke(f, g);
+                }
+            };
+
+            template <class Body>
+            struct _Range {
+                Body        *body;
+                size_t      begin;
+                size_t      end;
+                size_t      grain;
+                thread_pool *pool;
+
+                _Range(Body *pBody, size_t pBegin, size_t pEnd, size_t pGrain, thread_pool *pPool)
+                    : body(pBody), begin(pBegin), end(pEnd), grain(pGrain), pool(pPool) {}
+
+                void operator()() {
+                    if (end - begin <= grain) {
+                        for (size_t i = begin; i < end; i++)
+                            (*body)(i);
+                        return ;
+                    }
+                    size_t mid = begin + (end - begin) / 2;
+                    _Range left(body, begin, mid, grain, pool);
+                    _Range right(body, mid, end, grain, pool);
+                    pool->invoke(left, right);
+                }
+            };
+
+        public:
+            // threads = 0 starts one worker per online cpu
+            explicit thread_pool(size_t threads = 0)
+                : _workers(NULL), _count(threads), _stop(false), _sleepers(0), _injectedCount(0)
+            {
+                if (_count == 0) {
+                    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+                    _count = cpus > 0 ? cpus : 1;
+                }
+                pthread_mutex_init(&_sleepLock, NULL);
+                pthread_cond_init(&_sleepCond, NULL);
+                pthread_mutex_init(&_doneLock, NULL);
+                pthread_cond_init(&_doneCond, NULL);
+                pthread_mutex_init(&_injectLock, NULL);
+                _workers = new _Worker[_count];
+                for (size_t i = 0; i < _count; i++) {
+                    _workers[i].pool = this;
+                    _workers[i].rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+                }
+                for (size_t i = 0; i < _count; i++) {
+                    if (pthread_create(&_workers[i].thread, NULL, _main, &_workers[i]) != 0) {
+                        _shutdown(i);
+                        throw std::runtime_error("thread_pool: cannot start worker");
+                    }
+                }
+            }
+
+            // every submitted task must have completed
+            ~thread_pool() {
+                _shutdown(_count);
+            }
+
+            // the pool used when none is given, started on first use
+            static thread_pool &global() {
+                static thread_pool pool;
+                return pool;
+            }
+
+            size_t concurrency() const {
+                return _count;
+            }
+
+            // runs f() on the pool and returns once it did
+            template <class Function>
+            void run(Function f) {
+                if (_self()) {
+                    f();
+                    return ;
+                }
+                detail::function_task<Function> task(f);
+                _submitAndWait(&task);
+            }
+
+            // runs f() and g(), possibly in parallel, returns once both did
+            template <class Function1, class Function2>
+            void invoke(Function1 &f, Function2 &g) {
+                _Worker *self = _self();
+                if (!self) {
+                    _Invoke<Function1, Function2> root(f, g, this);
+                    detail::function_task<_Invoke<Function1, Function2> > task(root);
+                    _submitAndWait(&task);
+                    return ;
+                }
+                detail::function_task<Function2> forked(g);
+                self->deque.push(&forked);
+                _notify();
+                try {
+                    f();
+                } catch (...) {
+                    std::terminate();
+                }
+                _join(self, &forked);
+            }
+
+            // calls body(i) for every i in [first, last). Ranges are split
+            // in halves down to grain indices, 0 picks a grain giving every
+            // worker about eight pieces, enough for stealing to even out
+            // uneven iterations.
+            template <class Body>
+            void for_each_index(size_t first, size_t last, Body &body, size_t grain = 0) {
+                if (first >= last)
+                    return ;
+                if (grain == 0)
+                    grain = (last - first) / (8 * _count);
+                if (grain == 0)
+                    grain = 1;
+                _Range<Body> range(&body, first, last, grain, this);
+                run(range);
+            }
+    };
+
+    // runs two jobs on a pool, for the fork/join operations of the
+    // containers (see RedBlackTree's sequential_invoke)
+    struct pool_invoke {
+        thread_pool *pool;
+
+        explicit pool_invoke(thread_pool &pPool) : pool(&pPool) {}
+
+        template <class Function1, class Function2>
+        void operator()(Function1 &f, Function2 &g) const {
+            pool->invoke(f, g);
+        }
+
+        // levels of a balanced recursion worth forking: enough tasks for
+        // every worker to steal a few
+        size_t forks() const {
+            size_t levels = 3;
+            for (size_t n = pool->concurrency(); n > 1; n >>= 1)
+                levels++;
+            return levels;
+        }
+    };
+
+    // fork/join helpers, on the global pool unless one is given
+    template <class Function1, class Function2>
+    void parallel_invoke(thread_pool &pool, Function1 f, Function2 g) {
+        pool.invoke(f, g);
+    }
+
+    template <class Function1, class Function2>
+    void parallel_invoke(Function1 f, Function2 g) {
+        thread_pool::global().invoke(f, g);
+    }
+
+    namespace detail {
+        template <class Function1, class Function2>
+        struct invoke_pair {
+            thread_pool &pool;
+            Function1   &f;
+            Function2   &g;
+
+            invoke_pair(thread_pool &pPool, Function1 &pF, Function2 &pG) : pool(pPool), f(pF), g(pG) {}
+
+            void operator()() {
+                pool.invoke(f, g);
+            }
+        };
+    } // namespace detail
+
+    template <class Function1, class Function2, class Function3>
+    void parallel_invoke(thread_pool &pool, Function1 f, Function2 g, Function3 h) {
+        detail::invoke_pair<Function2, Function3> rest(pool, g, h);
+        pool.invoke(f, rest);
+    }
+
+    template <class Function1, class Function2, class Function3>
+    void parallel_invoke(Function1 f, Function2 g, Function3 h) {
+        ft::parallel_invoke(thread_pool::global(), f, g, h);
+    }
+
+    template <class Body>
+    void parallel_for(thread_pool &pool, size_t first, size_t last, Body body, size_t grain = 0) {
+        pool.for_each_index(first, last, body, grain);
+    }
+
+    template <class Body>
+    void parallel_for(size_t first, size_t last, Body body, size_t grain = 0) {
+        thread_pool::global().for_each_index(first, last, body, grain);
+    }
+} // namespace ft
+
+#endif
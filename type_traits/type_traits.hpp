@@ -4,6 +4,17 @@
 
 namespace ft
 {
+    // integral constant
+    template <class T, T v>
+    struct integral_constant {
+        typedef T                       value_type;
+        typedef integral_constant<T, v> type;
+        static const T value = v;
+    };
+
+    typedef integral_constant<bool, true>  true_type;
+    typedef integral_constant<bool, false> false_type;
+
     // enable if
     template <bool Cond, class T = void>
     struct enable_if {};
@@ -30,6 +41,7 @@ namespace ft
         static const bool value = true;
     };
 
+#if __cplusplus >= 201103L
     template <>
     struct is_integral<char16_t> {
         static const bool value = true;
@@ -39,6 +51,7 @@ namespace ft
     struct is_integral<char32_t> {
         static const bool value = true;
     };
+#endif
 
     template <>
     struct is_integral<wchar_t> {
@@ -94,6 +107,67 @@ namespace ft
     struct is_integral<unsigned long long int> {
         static const bool value = true;
     };
+
+    // is floating point
+    template <class T>
+    struct is_floating_point : public false_type {};
+
+    template <>
+    struct is_floating_point<float> : public true_type {};
+
+    template <>
+    struct is_floating_point<double> : public true_type {};
+
+    template <>
+    struct is_floating_point<long double> : public true_type {};
+
+    // is pointer
+    template <class T>
+    struct is_pointer : public false_type {};
+
+    template <class T>
+    struct is_pointer<T*> : public true_type {};
+
+    // is same
+    template <class T, class U>
+    struct is_same : public false_type {};
+
+    template <class T>
+    struct is_same<T, T> : public true_type {};
+
+    // remove const
+    template <class T>
+    struct remove_const {
+        typedef T type;
+    };
+
+    template <class T>
+    struct remove_const<const T> {
+        typedef T type;
+    };
+
+    // is trivially relocatable: moving the bytes of a T to another address
+    // yields a valid T, specialize it for your own types to let containers
+    // grow them with realloc/mremap instead of copy construction
+    template <class T>
+    struct is_trivially_relocatable
+        : public integral_constant<bool, is_integral<T>::value
+                                         || is_floating_point<T>::value
+                                         || is_pointer<T>::value> {};
+
+    // is trivially destructible: destroying a T does nothing, so containers
+    // may drop elements without calling the destructor. C++98 cannot tell
+    // on its own, the compiler's builtin can
+    template <class T>
+    struct is_trivially_destructible
+        : public integral_constant<bool, __has_trivial_destructor(T)> {};
+
+    // is trivially copyable: a T may be copied with memcpy, which is what
+    // writing it to a file and reading it back through a mapping does
+    template <class T>
+    struct is_trivially_copyable
+        : public integral_constant<bool, __has_trivial_copy(T)
+                                         && __has_trivial_destructor(T)> {};
 } // namespace ft
 
 
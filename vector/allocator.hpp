@@ -0,0 +1,106 @@
+#ifndef _ALLOCATOR_HPP_INCLUDED_
+#define _ALLOCATOR_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstdlib>
+#include <new>
+#include <limits>
+#include "type_traits.hpp"
+
+namespace ft {
+    // allocators that can grow a block in place (or move it without running
+    // copy constructors) specialize this to true and provide
+    // T *reallocate(T *p, size_type old_n, size_type new_n)
+    template <class Alloc>
+    struct allocator_can_reallocate : public false_type {};
+
+    // allocator backed by malloc/realloc/free
+    template <class T>
+    class malloc_allocator {
+        public:
+            typedef T         value_type;
+            typedef T*        pointer;
+            typedef const T*  const_pointer;
+            typedef T&        reference;
+            typedef const T&  const_reference;
+            typedef size_t    size_type;
+            typedef ptrdiff_t difference_type;
+
+            template <class U>
+            struct rebind {
+                typedef malloc_allocator<U> other;
+            };
+
+            malloc_allocator() {}
+
+            malloc_allocator(malloc_allocator const &) {}
+
+            template <class U>
+            malloc_allocator(malloc_allocator<U> const &) {}
+
+            ~malloc_allocator() {}
+
+            pointer address(reference x) const {
+                return &x;
+            }
+
+            const_pointer address(const_reference x) const {
+                return &x;
+            }
+
+            pointer allocate(size_type n, const void * = 0) {
+                if (n == 0)
+                    return NULL;
+                if (n > max_size())
+                    throw std::bad_alloc();
+                void *p = std::malloc(n * sizeof(T));
+                if (!p)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(p);
+            }
+
+            pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+                (void) old_n;
+                if (new_n == 0) {
+                    std::free(p);
+                    return NULL;
+                }
+                if (new_n > max_size())
+                    throw std::bad_alloc();
+                void *np = std::realloc(p, new_n * sizeof(T));
+                if (!np)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(np);
+            }
+
+            void deallocate(pointer p, size_type) {
+                std::free(p);
+            }
+
+            size_type max_size() const {
+                return std::numeric_limits<size_type>::max() / sizeof(T);
+            }
+
+            void construct(pointer p, const_reference val) {
+                new (static_cast<void*>(p)) T(val);
+            }
+
+            void destroy(pointer p) {
+                p->~T();
+            }
+    };
+
+    template <class T, class U>
+    bool operator==(malloc_allocator<T> const &, malloc_allocator<U> const &) {
+        return true;
+    }
+
+    template <class T, class U>
+    bool operator!=(malloc_allocator<T> const &, malloc_allocator<U> const &) {
+        return false;
+    }
+
+    template <class T>
+    struct allocator_can_reallocate<malloc_allocator<T> > : public true_type {};
+} // namespace ft
+
+#endif
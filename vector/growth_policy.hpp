@@ -0,0 +1,52 @@
+#ifndef _GROWTH_POLICY_HPP_INCLUDED_
+#define _GROWTH_POLICY_HPP_INCLUDED_
+#include "common.hpp"
+
+namespace ft {
+    // growth policies decide the capacity a vector moves to once it needs
+    // room for `required` elements, they all return at least `required`
+
+    // capacity * 2
+    struct grow_double {
+        static size_t next(size_t capacity, size_t required, size_t elem_size) {
+            (void) elem_size;
+            size_t grown = capacity * 2;
+            return grown > required ? grown : required;
+        }
+    };
+
+    // capacity * 1.5, freed blocks can be reused by later growth
+    struct grow_by_half {
+        static size_t next(size_t capacity, size_t required, size_t elem_size) {
+            (void) elem_size;
+            size_t grown = capacity + capacity / 2;
+            return grown > required ? grown : required;
+        }
+    };
+
+    // capacity * 2 rounded up so the buffer ends on a page boundary
+    template <size_t PageSize = 4096>
+    struct grow_page_rounded {
+        static size_t next(size_t capacity, size_t required, size_t elem_size) {
+            size_t grown = grow_double::next(capacity, required, elem_size);
+            size_t bytes = (grown * elem_size + PageSize - 1) / PageSize * PageSize;
+            return bytes / elem_size;
+        }
+    };
+
+    // capacity * 1.5 rounded up to the malloc size class it would land in
+    // anyway (four classes per power of two), the slack becomes capacity
+    struct grow_size_class {
+        static size_t next(size_t capacity, size_t required, size_t elem_size) {
+            size_t grown = grow_by_half::next(capacity, required, elem_size);
+            size_t bytes = grown * elem_size;
+            size_t spacing = 16;
+            while (spacing * 8 <= bytes)
+                spacing *= 2;
+            bytes = (bytes + spacing - 1) / spacing * spacing;
+            return bytes / elem_size;
+        }
+    };
+} // namespace ft
+
+#endif
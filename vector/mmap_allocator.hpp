@@ -0,0 +1,184 @@
+#ifndef _MMAP_ALLOCATOR_HPP_INCLUDED_
+#define _MMAP_ALLOCATOR_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <limits>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "allocator.hpp"
+
+namespace ft {
+    // allocator for huge buffers: blocks of at least Threshold bytes are
+    // anonymous mappings that grow with mremap (the kernel moves page table
+    // entries, no bytes are copied and the old block never coexists with
+    // the new one), smaller blocks come from malloc.
+    // With HugePages the mappings are madvise'd MADV_HUGEPAGE so scans hit
+    // fewer TLB misses when transparent huge pages are enabled.
+    template <class T, size_t Threshold = (1 << 20), bool HugePages = false>
+    class mmap_allocator {
+        private:
+            static size_t _pageSize() {
+                static size_t page = sysconf(_SC_PAGESIZE);
+                return page;
+            }
+
+            // n * sizeof(T) rounded up to pages must not wrap around
+            static void _checkSize(size_t n) {
+                if (n > (std::numeric_limits<size_t>::max() - _pageSize()) / sizeof(T))
+                    throw std::bad_alloc();
+            }
+
+            static size_t _mappedBytes(size_t n) {
+                size_t page = _pageSize();
+                return (n * sizeof(T) + page - 1) / page * page;
+            }
+
+            static bool _isMapped(size_t n) {
+                return n * sizeof(T) >= Threshold;
+            }
+
+            static void _advise(void *p, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+                if (HugePages)
+                    madvise(p, bytes, MADV_HUGEPAGE);
+#else
+                (void) p, (void) bytes;
+#endif
+            }
+
+            static void *_map(size_t n) {
+                size_t bytes = _mappedBytes(n);
+                void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED)
+                    throw std::bad_alloc();
+                _advise(p, bytes);
+                return p;
+            }
+
+            static void *_remap(void *p, size_t old_n, size_t new_n) {
+                size_t old_bytes = _mappedBytes(old_n);
+                size_t new_bytes = _mappedBytes(new_n);
+                if (old_bytes == new_bytes)
+                    return p;
+#ifdef MREMAP_MAYMOVE
+                void *np = mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+                if (np == MAP_FAILED)
+                    throw std::bad_alloc();
+                if (new_bytes > old_bytes)
+                    _advise(np, new_bytes);
+                return np;
+#else
+                void *np = _map(new_n);
+                std::memcpy(np, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+                munmap(p, old_bytes);
+                return np;
+#endif
+            }
+
+        public:
+            typedef T         value_type;
+            typedef T*        pointer;
+            typedef const T*  const_pointer;
+            typedef T&        reference;
+            typedef const T&  const_reference;
+            typedef size_t    size_type;
+            typedef ptrdiff_t difference_type;
+
+            template <class U>
+            struct rebind {
+                typedef mmap_allocator<U, Threshold, HugePages> other;
+            };
+
+            mmap_allocator() {}
+
+            mmap_allocator(mmap_allocator const &) {}
+
+            template <class U>
+            mmap_allocator(mmap_allocator<U, Threshold, HugePages> const &) {}
+
+            ~mmap_allocator() {}
+
+            pointer address(reference x) const {
+                return &x;
+            }
+
+            const_pointer address(const_reference x) const {
+                return &x;
+            }
+
+            pointer allocate(size_type n, const void * = 0) {
+                if (n == 0)
+                    return NULL;
+                _checkSize(n);
+                if (_isMapped(n))
+                    return static_cast<pointer>(_map(n));
+                void *p = std::malloc(n * sizeof(T));
+                if (!p)
+                    throw std::bad_alloc();
+                return static_cast<pointer>(p);
+            }
+
+            // only valid for trivially relocatable T, see allocator_can_reallocate
+            pointer reallocate(pointer p, size_type old_n, size_type new_n) {
+                if (!p)
+                    return allocate(new_n);
+                if (new_n == 0) {
+                    deallocate(p, old_n);
+                    return NULL;
+                }
+                _checkSize(new_n);
+                if (_isMapped(old_n) && _isMapped(new_n))
+                    return static_cast<pointer>(_remap(p, old_n, new_n));
+                if (!_isMapped(old_n) && !_isMapped(new_n)) {
+                    void *np = std::realloc(p, new_n * sizeof(T));
+                    if (!np)
+                        throw std::bad_alloc();
+                    return static_cast<pointer>(np);
+                }
+                // crossing the threshold, the block changes owner once
+                pointer np = allocate(new_n);
+                std::memcpy(static_cast<void*>(np), static_cast<void*>(p), \
+                            (old_n < new_n ? old_n : new_n) * sizeof(T));
+                deallocate(p, old_n);
+                return np;
+            }
+
+            void deallocate(pointer p, size_type n) {
+                if (!p)
+                    return ;
+                if (_isMapped(n))
+                    munmap(static_cast<void*>(p), _mappedBytes(n));
+                else
+                    std::free(p);
+            }
+
+            size_type max_size() const {
+                return (std::numeric_limits<size_type>::max() - _pageSize()) / sizeof(T);
+            }
+
+            void construct(pointer p, const_reference val) {
+                new (static_cast<void*>(p)) T(val);
+            }
+
+            void destroy(pointer p) {
+                p->~T();
+            }
+    };
+
+    template <class T, class U, size_t Threshold, bool HugePages>
+    bool operator==(mmap_allocator<T, Threshold, HugePages> const &, mmap_allocator<U, Threshold, HugePages> const &) {
+        return true;
+    }
+
+    template <class T, class U, size_t Threshold, bool HugePages>
+    bool operator!=(mmap_allocator<T, Threshold, HugePages> const &, mmap_allocator<U, Threshold, HugePages> const &) {
+        return false;
+    }
+
+    template <class T, size_t Threshold, bool HugePages>
+    struct allocator_can_reallocate<mmap_allocator<T, Threshold, HugePages> > : public true_type {};
+} // namespace ft
+
+#endif
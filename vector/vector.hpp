@@ -1,12 +1,15 @@
 #ifndef _VECTOR_HPP_INCLUDED_
 #define _VECTOR_HPP_INCLUDED_
-#define Max(x, y) ((x > y) ? (x) : (y))
 #include "common.hpp"
 #include "iterator.hpp"
 #include "VectorIterator.hpp"
+#include "algorithm.hpp"
+#include "type_traits.hpp"
+#include "allocator.hpp"
+#include "growth_policy.hpp"
 
 namespace ft {
-    template <class T, class Alloc = std::allocator<T> >
+    template <class T, class Alloc = std::allocator<T>, class Growth = grow_double>
     class vector {
         private:
             T*     _arr;
@@ -14,7 +17,20 @@ namespace ft {
             size_t _capacity;
             Alloc  _alloc;
 
+            typedef integral_constant<bool, is_trivially_relocatable<T>::value
+                                            && allocator_can_reallocate<Alloc>::value> _can_realloc;
+
             void _reAlloc(typename Alloc::size_type new_capacity) {
+                _reAlloc(new_capacity, _can_realloc());
+            }
+
+            // the allocator moves the bytes for us (realloc/mremap)
+            void _reAlloc(typename Alloc::size_type new_capacity, true_type) {
+                _arr = _alloc.reallocate(_arr, _capacity, new_capacity);
+                _capacity = new_capacity;
+            }
+
+            void _reAlloc(typename Alloc::size_type new_capacity, false_type) {
                 T *new_arr = _alloc.allocate(new_capacity);
 
                 for (size_t i = 0; i < _size && i < new_capacity; i++) {
@@ -26,6 +42,22 @@ namespace ft {
                 _capacity = new_capacity;
             }
 
+            void _grow(typename Alloc::size_type required) {
+                if (required > _capacity)
+                    _reAlloc(Growth::next(_capacity, required, sizeof(T)));
+            }
+
+            void _destroyRange(T* start, T* end) {
+                _destroyRange(start, end, is_trivially_destructible<T>());
+            }
+
+            void _destroyRange(T*, T*, true_type) {}
+
+            void _destroyRange(T* start, T* end, false_type) {
+                for (; start < end; start++)
+                    _alloc.destroy(start);
+            }
+
             void _moveRangeSTE(T* start, T* end, T* dest) { // start to end
                 while (start < end) {
                     if (dest < end) {
@@ -65,6 +97,101 @@ namespace ft {
                 _moveRangeETS(start, end, dest);
             }
 
+            void _reverse(T* start, T* end) {
+                while (start < --end) {
+                    T tmp(*start);
+                    *start++ = *end;
+                    *end = tmp;
+                }
+            }
+
+            // ranges: only random access ones are measured up front, into
+            // one allocation of the right size. Any other range is walked
+            // once, growing as it goes, as counting it would be a second
+            // walk (a whole tree for map iterators) or would consume it
+            template <class Integer>
+            void _assignRange(Integer n, Integer val, true_type) {
+                assign(size_type(n), value_type(val));
+            }
+
+            template <class InputIterator>
+            void _assignRange(InputIterator first, InputIterator last, false_type) {
+                _assignRange(first, last, typename iterator_traits<InputIterator>::iterator_category());
+            }
+
+            template <class InputIterator>
+            void _assignRange(InputIterator first, InputIterator last, input_iterator_tag) {
+                size_t i = 0;
+                for (; i < _size && first != last; ++i, ++first)
+                    _arr[i] = *first;
+                if (first == last) {
+                    while (_size > i)
+                        pop_back();
+                    return ;
+                }
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+
+            template <class RandomAccessIterator>
+            void _assignRange(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+                size_t n = last - first;
+                if (n > _capacity) {
+                    clear();
+                    if (_arr)
+                        _alloc.deallocate(_arr, _capacity);
+                    _arr = _alloc.allocate(n);
+                    _capacity = n;
+                }
+                size_t i = 0;
+                for (; i < _size && i < n; ++i, ++first)
+                    _arr[i] = *first;
+                for (; i < n; ++i, ++first)
+                    _alloc.construct(&_arr[i], *first);
+                while (_size > n)
+                    pop_back();
+                _size = n;
+            }
+
+            template <class Integer>
+            void _insertRange(size_t pos, Integer n, Integer val, true_type) {
+                insert(begin() + pos, size_type(n), value_type(val));
+            }
+
+            template <class InputIterator>
+            void _insertRange(size_t pos, InputIterator first, InputIterator last, false_type) {
+                _insertRange(pos, first, last, typename iterator_traits<InputIterator>::iterator_category());
+            }
+
+            // appended in one pass, then rotated into place
+            template <class InputIterator>
+            void _insertRange(size_t pos, InputIterator first, InputIterator last, input_iterator_tag) {
+                size_t old_size = _size;
+                for (; first != last; ++first)
+                    push_back(*first);
+                if (_size == old_size)
+                    return ;
+                _reverse(&_arr[pos], &_arr[old_size]);
+                _reverse(&_arr[old_size], &_arr[_size]);
+                _reverse(&_arr[pos], &_arr[_size]);
+            }
+
+            template <class RandomAccessIterator>
+            void _insertRange(size_t pos, RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+                size_t n = last - first;
+                _grow(_size + n);
+                value_type* ptr = &_arr[pos];
+                _moveRange(ptr, &_arr[_size], &ptr[n]);
+                for (size_t i = 0; i < n; i++) {
+                    if (ptr < &_arr[_size])
+                        *(ptr++) = *first;
+                    else
+                        _alloc.construct(ptr++, *first);
+                    first++;
+                }
+                _size += n;
+            }
+
         public:
             typedef T                                                   value_type;
             typedef Alloc                                               allocator_type;
@@ -76,6 +203,7 @@ namespace ft {
             typedef ft::reverse_iterator<iterator>                      reverse_iterator;
             typedef typename iterator_traits<iterator>::difference_type difference_type;
             typedef typename allocator_type::size_type                  size_type;
+            typedef Growth                                              growth_policy;
 
             // constructors
             vector(const allocator_type& alloc = allocator_type()) {
@@ -100,13 +228,11 @@ namespace ft {
             vector(InputIterator begin, InputIterator end, \
                         const allocator_type& alloc = allocator_type())
             {
-                difference_type n = distance(begin, end);
                 _alloc = alloc;
-                _arr = _alloc.allocate(n);
-                _size = n;
-                _capacity = n;
-                for (size_t i = 0; begin != end; begin++, i++)
-                    _alloc.construct(&_arr[i], *begin);
+                _arr = NULL;
+                _size = 0;
+                _capacity = 0;
+                _assignRange(begin, end, integral_constant<bool, is_integral<InputIterator>::value>());
             }
 
             vector(const vector& obj) {
@@ -137,6 +263,7 @@ namespace ft {
                         _arr[i] = rhs._arr[i];
                     for (size_t i = rhs._size; i < _size; i++)
                         _alloc.destroy(&_arr[i]);
+                    _size = rhs._size;
                     return *this;
                 }
                 for (size_t i = 0; i < _size; i++)
@@ -195,9 +322,7 @@ namespace ft {
             }
 
             void resize(size_type n, value_type val = value_type()) {
-                if (n > _capacity) {
-                    _reAlloc(Max(_capacity * 2, n));
-                }
+                _grow(n);
                 for (size_t i = n; i < _size; i++) // if n < size
                     _alloc.destroy(&_arr[i]);
                 for (size_t i = _size; i < n; i++) // if n > size
@@ -219,6 +344,19 @@ namespace ft {
                 _reAlloc(n);
             }
 
+            // gives back the capacity beyond size()
+            void shrink_to_fit() {
+                if (_capacity == _size)
+                    return ;
+                if (_size == 0) {
+                    _alloc.deallocate(_arr, _capacity);
+                    _arr = NULL;
+                    _capacity = 0;
+                    return ;
+                }
+                _reAlloc(_size);
+            }
+
             // element access
             reference operator[] (size_type n) {
                 return _arr[n];
@@ -265,14 +403,7 @@ namespace ft {
             // modifiers
             template <class InputIterator> 
             void assign(InputIterator first, InputIterator last) {
-                size_t new_size = distance(first, last);
-                if (new_size > _capacity)
-                    _reAlloc(new_size);
-                for (size_t i = new_size; i < _size; i++) // if new_size < size
-                    _alloc.destroy(&_arr[i]);
-                for (size_t i = 0; i < new_size; i++)
-                    _alloc.construct(&_arr[i], *(first++));
-                _size = new_size;
+                _assignRange(first, last, integral_constant<bool, is_integral<InputIterator>::value>());
             }
 
             void assign(size_type n, const value_type& val) {
@@ -286,34 +417,32 @@ namespace ft {
             }
 
             void push_back(const value_type& val) {
-                if (_size >= _capacity)
-                    _reAlloc(Max(_capacity * 2, 1)); // one if current _capacity is 0
-                _alloc.construct(&_arr[_size], val);
+                if (_size >= _capacity) {
+                    value_type tmp(val); // val may live in the buffer we are about to free
+                    _grow(_size + 1);
+                    _alloc.construct(&_arr[_size], tmp);
+                }
+                else
+                    _alloc.construct(&_arr[_size], val);
                 _size++;
             }
 
             void pop_back() {
                 if (empty())
                     return ;
-                _alloc.destroy(&_arr[_size]);
                 _size--;
+                _alloc.destroy(&_arr[_size]);
             }
 
             iterator insert(iterator position, const value_type& val) {
                 int64_t pos = position - begin();
-                if (_size >= _capacity)
-                    _reAlloc(Max(_capacity * 2, 1)); // one if current _capacity is 0
-                value_type* ptr = &_arr[pos];
-                _moveRange(ptr, &_arr[_size], &ptr[1]);
-                *ptr = val;
-                _size++;
-                return position;
+                insert(position, size_type(1), val);
+                return iterator(&_arr[pos]);
             }
 
             void insert (iterator position, size_type n, const value_type& val) {
                 int64_t pos = position - begin();
-                if (_size + n > _capacity)
-                    _reAlloc(Max(_capacity * 2, _size + n));
+                _grow(_size + n);
                 value_type* ptr = &_arr[pos];
                 _moveRange(ptr, &_arr[_size], &ptr[n]);
                 for (size_type i = 0; i < n; i++) {
@@ -327,40 +456,20 @@ namespace ft {
 
             template <class InputIterator>
             void insert (iterator position, InputIterator first, InputIterator last) {
-                int64_t pos = position - begin();
-                difference_type n = distance(first, last);
-                if (_size + n > _capacity)
-                    _reAlloc(Max(_capacity * 2, _size + n));
-                value_type* ptr = &_arr[pos];
-                _moveRange(ptr, &_arr[_size], &ptr[n]);
-                for (int64_t i = 0; i < n; i++) {
-                    if (ptr < &_arr[_size])
-                        *(ptr++) = *first;
-                    else
-                        _alloc.construct(ptr++, *first);
-                    first++;
-                }
-                _size += n;
+                _insertRange(position - begin(), first, last, integral_constant<bool, is_integral<InputIterator>::value>());
             }
 
             iterator erase(iterator position) {
-                int64_t pos = position - begin();
-                _alloc.destroy(&_arr[pos]);
-                value_type* ptr = &_arr[pos];
-                _moveRange(ptr, &_arr[_size], &ptr[-1]);
-                _size--;
-                return iterator(&_arr[pos]);
+                return erase(position, position + 1);
             }
             
             iterator erase(iterator first, iterator last) {
                 int64_t pos = first - begin();
-                value_type* ptr = &_arr[pos];
-                int64_t diff = distance(first, last);
-                for (int i = 0; first < last; i++) {
-                    _alloc.destroy(&_arr[pos + i]);
-                    first++;
-                }
-                _moveRange(&_arr[last - begin()], &ptr[_size], ptr);
+                int64_t diff = ft::distance(first, last);
+                if (diff == 0)
+                    return first;
+                _moveRange(&_arr[pos + diff], &_arr[_size], &_arr[pos]);
+                _destroyRange(&_arr[_size - diff], &_arr[_size]);
                 _size -= diff;
                 return iterator(&_arr[pos]);
             }
@@ -392,41 +501,53 @@ namespace ft {
     };
 
     // relational operators
-    template <class T, class Alloc>
-    bool operator==(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
-        return lhs.size() == rhs.size && equal(lhs.begin(), lhs.end(), rhs.begin());
+    template <class T, class Alloc, class Growth>
+    bool operator==(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template <class T, class Alloc>
-    bool operator!=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
+    template <class T, class Alloc, class Growth>
+    bool operator!=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
         return !(lhs == rhs);
     }
 
-    template <class T, class Alloc>
-    bool operator<(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
-        return lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    template <class T, class Alloc, class Growth>
+    bool operator<(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template <class T, class Alloc>
-    bool operator<=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
+    template <class T, class Alloc, class Growth>
+    bool operator<=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
         return !(rhs < lhs);
     }
 
-    template <class T, class Alloc>
-    bool operator>(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
+    template <class T, class Alloc, class Growth>
+    bool operator>(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
         return rhs < lhs;
     }
 
-    template <class T, class Alloc>
-    bool operator>=(const vector<T,Alloc>& lhs, const vector<T,Alloc>& rhs) {
+    template <class T, class Alloc, class Growth>
+    bool operator>=(const vector<T,Alloc,Growth>& lhs, const vector<T,Alloc,Growth>& rhs) {
         return !(lhs < rhs);
     }
 
     // swap
-    template <class T, class Alloc>
-    void swap(vector<T,Alloc>& x, vector<T,Alloc>& y) {
+    template <class T, class Alloc, class Growth>
+    void swap(vector<T,Alloc,Growth>& x, vector<T,Alloc,Growth>& y) {
         x.swap(y);
     }
+
+    // erases every element pred holds for in one stable pass, each
+    // survivor is assigned at most once. Returns how many went
+    template <class T, class Alloc, class Growth, class Predicate>
+    typename vector<T,Alloc,Growth>::size_type erase_if(vector<T,Alloc,Growth>& c, Predicate pred) {
+        typename vector<T,Alloc,Growth>::iterator last = ft::remove_if(c.begin(), c.end(), pred);
+        typename vector<T,Alloc,Growth>::size_type n = c.end() - last;
+        c.erase(last, c.end());
+        return n;
+    }
 } // namespace ft
 
+#include "vector_bool.hpp"
+
 #endif
\ No newline at end of file
@@ -0,0 +1,727 @@
+#ifndef _VECTOR_BOOL_HPP_INCLUDED_
+#define _VECTOR_BOOL_HPP_INCLUDED_
+#include "common.hpp"
+#include <cstring>
+#include "iterator.hpp"
+#include "algorithm.hpp"
+#include "simd.hpp"
+#include "growth_policy.hpp"
+#include "vector.hpp"
+
+// vector<bool> packs its flags 64 to a word, element i being bit i % 64 of
+// word i / 64. Bits at or past size() are kept zero in every word of the
+// capacity, so whole words can be counted and compared without masking.
+
+namespace ft {
+    class BitIterator;
+
+    namespace detail {
+        typedef uint64_t bit_word;
+
+        static const size_t bit_word_bits = 64;
+
+        inline size_t bit_words(size_t bits) {
+            return (bits + bit_word_bits - 1) / bit_word_bits;
+        }
+
+        // the bits of a word below bit n
+        inline bit_word bit_mask_below(size_t n) {
+            return n >= bit_word_bits ? ~bit_word(0) : (bit_word(1) << n) - 1;
+        }
+
+        // n <= 64 bits of w starting at bit pos, in the low bits
+        inline bit_word load_bits(const bit_word *w, size_t pos, size_t n) {
+            size_t   i = pos / bit_word_bits;
+            size_t   offset = pos % bit_word_bits;
+            bit_word bits = w[i] >> offset;
+            if (offset && offset + n > bit_word_bits)
+                bits |= w[i + 1] << (bit_word_bits - offset);
+            return bits & bit_mask_below(n);
+        }
+
+        // writes the n <= 64 low bits of bits to w at bit pos
+        inline void store_bits(bit_word *w, size_t pos, bit_word bits, size_t n) {
+            size_t   i = pos / bit_word_bits;
+            size_t   offset = pos % bit_word_bits;
+            bit_word mask = bit_mask_below(n);
+            bits &= mask;
+            w[i] = (w[i] & ~(mask << offset)) | (bits << offset);
+            if (offset + n > bit_word_bits) {
+                size_t shift = bit_word_bits - offset;
+                w[i + 1] = (w[i + 1] & ~(mask >> shift)) | (bits >> shift);
+            }
+        }
+
+        // sets or clears the bits [first, last) of w
+        inline void fill_bits(bit_word *w, size_t first, size_t last, bool val) {
+            if (first >= last)
+                return ;
+            size_t   i = first / bit_word_bits;
+            size_t   j = last / bit_word_bits;
+            bit_word head = ~bit_word(0) << (first % bit_word_bits);
+            if (i == j) {
+                head &= bit_mask_below(last % bit_word_bits);
+                w[i] = val ? w[i] | head : w[i] & ~head;
+                return ;
+            }
+            w[i] = val ? w[i] | head : w[i] & ~head;
+            std::memset(w + i + 1, val ? 0xff : 0, (j - i - 1) * sizeof(bit_word));
+            if (last % bit_word_bits) {
+                bit_word tail = bit_mask_below(last % bit_word_bits);
+                w[j] = val ? w[j] | tail : w[j] & ~tail;
+            }
+        }
+
+        // moves the n bits at from to to, the ranges may overlap
+        inline void move_bits(bit_word *w, size_t from, size_t to, size_t n) {
+            if (from == to || n == 0)
+                return ;
+            if (to < from) {
+                for (size_t k = 0; k < n; k += bit_word_bits) {
+                    size_t chunk = n - k < bit_word_bits ? n - k : bit_word_bits;
+                    store_bits(w, to + k, load_bits(w, from + k, chunk), chunk);
+                }
+                return ;
+            }
+            for (size_t k = n; k > 0;) {
+                size_t chunk = k < bit_word_bits ? k : bit_word_bits;
+                k -= chunk;
+                store_bits(w, to + k, load_bits(w, from + k, chunk), chunk);
+            }
+        }
+
+        // number of set bits in [first, last)
+        inline size_t count_bits(const bit_word *w, size_t first, size_t last) {
+            if (first >= last)
+                return 0;
+            size_t   i = first / bit_word_bits;
+            size_t   j = last / bit_word_bits;
+            bit_word head = w[i] >> (first % bit_word_bits);
+            if (i == j)
+                return __builtin_popcountll(head & bit_mask_below(last - first));
+            size_t count = __builtin_popcountll(head) + popcount_words(w + i + 1, j - i - 1);
+            if (last % bit_word_bits)
+                count += __builtin_popcountll(w[j] & bit_mask_below(last % bit_word_bits));
+            return count;
+        }
+
+        // the word an iterator is in, and its bit there
+        struct bit_access {
+            static bit_word *word(BitIterator const &it);
+            static size_t bit(BitIterator const &it);
+        };
+
+        // first bit of [first, last) equal to val, last if none. Words
+        // holding only the other value are skipped in bulk
+        inline size_t find_bit(const bit_word *w, size_t first, size_t last, bool val) {
+            bit_word skip = val ? 0 : ~bit_word(0);
+            size_t   end = last / bit_word_bits;
+            while (first < last) {
+                size_t   i = first / bit_word_bits;
+                bit_word hits = (w[i] ^ skip) >> (first % bit_word_bits);
+                if (hits) {
+                    size_t pos = first + __builtin_ctzll(hits);
+                    return pos < last ? pos : last;
+                }
+                i++;
+                if (i < end)
+                    i += find_word(w + i, end - i, skip);
+                first = i * bit_word_bits;
+            }
+            return last;
+        }
+    } // namespace detail
+
+    // stands for one bit of a vector<bool>
+    class bit_reference {
+        private:
+            detail::bit_word *_word;
+            detail::bit_word _mask;
+
+        public:
+            bit_reference(detail::bit_word *pWord, detail::bit_word pMask) : _word(pWord), _mask(pMask) {}
+
+            operator bool() const {
+                return (*_word & _mask) != 0;
+            }
+
+            bool operator~() const {
+                return !bool(*this);
+            }
+
+            bit_reference &operator=(bool x) {
+                if (x)
+                    *_word |= _mask;
+                else
+                    *_word &= ~_mask;
+                return *this;
+            }
+
+            bit_reference &operator=(bit_reference const &x) {
+                return *this = bool(x);
+            }
+
+            bool operator==(bit_reference const &x) const {
+                return bool(*this) == bool(x);
+            }
+
+            bool operator<(bit_reference const &x) const {
+                return !bool(*this) && bool(x);
+            }
+
+            void flip() {
+                *_word ^= _mask;
+            }
+    };
+
+    // a word and a bit in it
+    class BitIterator : public iterator<random_access_iterator_tag, bool> {
+        private:
+            detail::bit_word *_word;
+            size_t           _bit;
+
+            friend struct detail::bit_access;
+
+        public:
+            typedef bool                       value_type;
+            typedef ptrdiff_t                  difference_type;
+            typedef void                       pointer;
+            typedef bit_reference              reference;
+            typedef random_access_iterator_tag iterator_category;
+
+            BitIterator() : _word(NULL), _bit(0) {}
+
+            BitIterator(detail::bit_word *pWords, size_t pPos)
+                : _word(pWords + pPos / detail::bit_word_bits), _bit(pPos % detail::bit_word_bits) {}
+
+            bool operator==(BitIterator const &rhs) const {
+                return _word == rhs._word && _bit == rhs._bit;
+            }
+
+            bool operator!=(BitIterator const &rhs) const {
+                return !(*this == rhs);
+            }
+
+            reference operator*() const {
+                return reference(_word, detail::bit_word(1) << _bit);
+            }
+
+            reference operator[](difference_type n) const {
+                return *(*this + n);
+            }
+
+            BitIterator &operator++() {
+                if (++_bit == detail::bit_word_bits) {
+                    _bit = 0;
+                    _word++;
+                }
+                return *this;
+            }
+
+            BitIterator operator++(int) {
+                BitIterator tmp(*this);
+                ++(*this);
+                return tmp;
+            }
+
+            BitIterator &operator--() {
+                if (_bit-- == 0) {
+                    _bit = detail::bit_word_bits - 1;
+                    _word--;
+                }
+                return *this;
+            }
+
+            BitIterator operator--(int) {
+                BitIterator tmp(*this);
+                --(*this);
+                return tmp;
+            }
+
+            BitIterator &operator+=(difference_type n) {
+                difference_type bits = detail::bit_word_bits;
+                difference_type pos = static_cast<difference_type>(_bit) + n;
+                difference_type words = pos >= 0 ? pos / bits : -((bits - 1 - pos) / bits);
+                _word += words;
+                _bit = pos - words * bits;
+                return *this;
+            }
+
+            BitIterator &operator-=(difference_type n) {
+                return *this += -n;
+            }
+
+            BitIterator operator+(difference_type n) const {
+                BitIterator tmp(*this);
+                return tmp += n;
+            }
+
+            BitIterator operator-(difference_type n) const {
+                BitIterator tmp(*this);
+                return tmp -= n;
+            }
+
+            difference_type operator-(BitIterator const &rhs) const {
+                difference_type bits = detail::bit_word_bits;
+                return (_word - rhs._word) * bits + static_cast<difference_type>(_bit) - static_cast<difference_type>(rhs._bit);
+            }
+
+            bool operator<(BitIterator const &rhs) const {
+                return *this - rhs < 0;
+            }
+
+            bool operator>(BitIterator const &rhs) const {
+                return rhs < *this;
+            }
+
+            bool operator<=(BitIterator const &rhs) const {
+                return !(rhs < *this);
+            }
+
+            bool operator>=(BitIterator const &rhs) const {
+                return !(*this < rhs);
+            }
+    };
+
+    namespace detail {
+        inline bit_word *bit_access::word(BitIterator const &it) {
+            return it._word;
+        }
+
+        inline size_t bit_access::bit(BitIterator const &it) {
+            return it._bit;
+        }
+    } // namespace detail
+
+    inline BitIterator operator+(BitIterator::difference_type n, BitIterator const &rhs) {
+        return rhs + n;
+    }
+
+    template <class Alloc, class Growth>
+    class vector<bool, Alloc, Growth> {
+        private:
+            typedef detail::bit_word                                    word_type;
+            typedef typename Alloc::template rebind<word_type>::other   word_allocator;
+            typedef detail::bit_access                                  access;
+
+            word_type      *_words;
+            size_t         _size;
+            size_t         _capacity; // in words
+            word_allocator _alloc;
+
+            // new words start out zero, as bits past size() must be
+            void _reAlloc(size_t new_capacity) {
+                word_type *words = _alloc.allocate(new_capacity);
+                size_t    keep = detail::bit_words(_size);
+                if (keep > new_capacity)
+                    keep = new_capacity;
+                if (keep)
+                    std::memcpy(words, _words, keep * sizeof(word_type));
+                std::memset(words + keep, 0, (new_capacity - keep) * sizeof(word_type));
+                if (_words)
+                    _alloc.deallocate(_words, _capacity);
+                _words = words;
+                _capacity = new_capacity;
+            }
+
+            void _grow(size_t required) {
+                size_t words = detail::bit_words(required);
+                if (words > _capacity)
+                    _reAlloc(Growth::next(_capacity, words, sizeof(word_type)));
+            }
+
+            // drops the bits from n on
+            void _truncate(size_t n) {
+                if (n < _size)
+                    detail::fill_bits(_words, n, _size, false);
+                _size = n;
+            }
+
+            size_t _index(BitIterator const &it) const {
+                return (access::word(it) - _words) * detail::bit_word_bits + access::bit(it);
+            }
+
+            // ranges other than bit ranges go element by element, in one
+            // pass; only random access ones are measured to reserve first
+            template <class Integer>
+            void _assignRange(Integer n, Integer val, true_type) {
+                assign(size_type(n), bool(val));
+            }
+
+            template <class InputIterator>
+            void _assignRange(InputIterator first, InputIterator last, false_type) {
+                _truncate(0);
+                _reserveFor(first, last, typename iterator_traits<InputIterator>::iterator_category());
+                for (; first != last; ++first)
+                    push_back(bool(*first));
+            }
+
+            template <class InputIterator>
+            void _reserveFor(InputIterator, InputIterator, input_iterator_tag) {}
+
+            template <class RandomAccessIterator>
+            void _reserveFor(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag) {
+                reserve(_size + (last - first));
+            }
+
+            template <class Integer>
+            void _insertRange(size_t pos, Integer n, Integer val, true_type) {
+                insert(iterator(_words, pos), size_type(n), bool(val));
+            }
+
+            // appended in one pass, then moved into place through a copy
+            template <class InputIterator>
+            void _insertRange(size_t pos, InputIterator first, InputIterator last, false_type) {
+                size_t old_size = _size;
+                _reserveFor(first, last, typename iterator_traits<InputIterator>::iterator_category());
+                for (; first != last; ++first)
+                    push_back(bool(*first));
+                if (_size == old_size || pos == old_size)
+                    return ;
+                vector added(iterator(_words, old_size), end());
+                detail::move_bits(_words, pos, pos + added.size(), old_size - pos);
+                for (size_t k = 0; k < added.size(); k += detail::bit_word_bits) {
+                    size_t chunk = added.size() - k < detail::bit_word_bits ? added.size() - k : detail::bit_word_bits;
+                    detail::store_bits(_words, pos + k, detail::load_bits(added._words, k, chunk), chunk);
+                }
+            }
+
+            void _init(size_t n, bool val) {
+                _words = NULL;
+                _size = 0;
+                _capacity = 0;
+                if (n)
+                    _reAlloc(detail::bit_words(n));
+                detail::fill_bits(_words, 0, n, val);
+                _size = n;
+            }
+
+        public:
+            typedef bool                                                value_type;
+            typedef Alloc                                               allocator_type;
+            typedef bit_reference                                       reference;
+            typedef bool                                                const_reference;
+            typedef BitIterator                                         iterator;
+            typedef const BitIterator                                   const_iterator;
+            typedef ft::reverse_iterator<const_iterator>                const_reverse_iterator;
+            typedef ft::reverse_iterator<iterator>                      reverse_iterator;
+            typedef ptrdiff_t                                           difference_type;
+            typedef size_t                                              size_type;
+            typedef Growth                                              growth_policy;
+
+            // constructors
+            vector(const allocator_type& alloc = allocator_type()) : _alloc(alloc) {
+                _init(0, false);
+            }
+
+            vector(size_type n, const value_type &val = value_type(), \
+                        const allocator_type &alloc = allocator_type()) : _alloc(alloc)
+            {
+                _init(n, val);
+            }
+
+            template <class InputIterator>
+            vector(InputIterator begin, InputIterator end, \
+                        const allocator_type& alloc = allocator_type()) : _alloc(alloc)
+            {
+                _init(0, false);
+                assign(begin, end);
+            }
+
+            vector(const vector& obj) : _alloc(obj._alloc) {
+                _init(0, false);
+                *this = obj;
+            }
+
+            ~vector() {
+                if (_words)
+                    _alloc.deallocate(_words, _capacity);
+            }
+
+            vector &operator=(const vector &rhs) {
+                if (this == &rhs)
+                    return *this;
+                size_t words = detail::bit_words(rhs._size);
+                if (words > _capacity)
+                    _reAlloc(words);
+                _truncate(0);
+                if (words)
+                    std::memcpy(_words, rhs._words, words * sizeof(word_type));
+                _size = rhs._size;
+                return *this;
+            }
+
+            // iterators
+            iterator begin() {
+                return iterator(_words, 0);
+            }
+
+            const_iterator begin() const {
+                return const_iterator(_words, 0);
+            }
+
+            iterator end() {
+                return iterator(_words, _size);
+            }
+
+            const_iterator end() const {
+                return const_iterator(_words, _size);
+            }
+
+            reverse_iterator rbegin() {
+                return reverse_iterator(end());
+            }
+
+            const_reverse_iterator rbegin() const {
+                return const_reverse_iterator(end());
+            }
+
+            reverse_iterator rend() {
+                return reverse_iterator(begin());
+            }
+
+            const_reverse_iterator rend() const {
+                return const_reverse_iterator(begin());
+            }
+
+            // capacity
+            size_type size() const {
+                return _size;
+            }
+
+            size_type max_size() const {
+                size_type words = _alloc.max_size();
+                return words > size_type(-1) / detail::bit_word_bits ? size_type(-1) : words * detail::bit_word_bits;
+            }
+
+            void resize(size_type n, value_type val = value_type()) {
+                if (n <= _size) {
+                    _truncate(n);
+                    return ;
+                }
+                _grow(n);
+                detail::fill_bits(_words, _size, n, val);
+                _size = n;
+            }
+
+            size_type capacity() const {
+                return _capacity * detail::bit_word_bits;
+            }
+
+            bool empty() const {
+                return _size == 0;
+            }
+
+            void reserve(size_type n) {
+                if (detail::bit_words(n) > _capacity)
+                    _reAlloc(detail::bit_words(n));
+            }
+
+            void shrink_to_fit() {
+                size_t words = detail::bit_words(_size);
+                if (words == _capacity)
+                    return ;
+                if (words == 0) {
+                    _alloc.deallocate(_words, _capacity);
+                    _words = NULL;
+                    _capacity = 0;
+                    return ;
+                }
+                _reAlloc(words);
+            }
+
+            // element access
+            reference operator[] (size_type n) {
+                return *iterator(_words, n);
+            }
+
+            const_reference operator[] (size_type n) const {
+                return (_words[n / detail::bit_word_bits] >> (n % detail::bit_word_bits)) & 1;
+            }
+
+            reference at(size_type n) {
+                if (n >= _size) throw std::out_of_range("vector");
+                return (*this)[n];
+            }
+
+            const_reference at(size_type n) const {
+                if (n >= _size) throw std::out_of_range("vector");
+                return (*this)[n];
+            }
+
+            reference front() {
+                return (*this)[0];
+            }
+
+            const_reference front() const {
+                return (*this)[0];
+            }
+
+            reference back() {
+                return (*this)[_size - 1];
+            }
+
+            const_reference back() const {
+                return (*this)[_size - 1];
+            }
+
+            // modifiers
+            template <class InputIterator>
+            void assign(InputIterator first, InputIterator last) {
+                _assignRange(first, last, integral_constant<bool, is_integral<InputIterator>::value>());
+            }
+
+            // a range of bits is copied a word at a time, even from this
+            // vector itself, which never needs to grow for it
+            void assign(iterator first, iterator last) {
+                size_t    n = last - first;
+                word_type *from = access::word(first);
+                if (from >= _words && from < _words + _capacity) {
+                    detail::move_bits(_words, _index(first), 0, n);
+                    _truncate(n);
+                    return ;
+                }
+                _grow(n);
+                _truncate(0);
+                for (size_t k = 0; k < n; k += detail::bit_word_bits) {
+                    size_t chunk = n - k < detail::bit_word_bits ? n - k : detail::bit_word_bits;
+                    detail::store_bits(_words, k, detail::load_bits(from, access::bit(first) + k, chunk), chunk);
+                }
+                _size = n;
+            }
+
+            void assign(size_type n, const value_type& val) {
+                _grow(n);
+                _truncate(0);
+                detail::fill_bits(_words, 0, n, val);
+                _size = n;
+            }
+
+            void push_back(const value_type& val) {
+                _grow(_size + 1);
+                if (val)
+                    _words[_size / detail::bit_word_bits] |= word_type(1) << (_size % detail::bit_word_bits);
+                _size++;
+            }
+
+            void pop_back() {
+                if (empty())
+                    return ;
+                _truncate(_size - 1);
+            }
+
+            iterator insert(iterator position, const value_type& val) {
+                size_t pos = _index(position);
+                insert(position, size_type(1), val);
+                return iterator(_words, pos);
+            }
+
+            void insert(iterator position, size_type n, const value_type& val) {
+                size_t pos = _index(position);
+                _grow(_size + n);
+                detail::move_bits(_words, pos, pos + n, _size - pos);
+                detail::fill_bits(_words, pos, pos + n, val);
+                _size += n;
+            }
+
+            template <class InputIterator>
+            void insert(iterator position, InputIterator first, InputIterator last) {
+                _insertRange(_index(position), first, last, integral_constant<bool, is_integral<InputIterator>::value>());
+            }
+
+            iterator erase(iterator position) {
+                return erase(position, position + 1);
+            }
+
+            iterator erase(iterator first, iterator last) {
+                size_t pos = _index(first);
+                size_t n = last - first;
+                detail::move_bits(_words, pos + n, pos, _size - pos - n);
+                _truncate(_size - n);
+                return iterator(_words, pos);
+            }
+
+            void swap(vector& x) {
+                word_type      *words = x._words;
+                size_t         size = x._size;
+                size_t         capacity = x._capacity;
+                word_allocator alloc = x._alloc;
+
+                x._words = _words;
+                x._size = _size;
+                x._capacity = _capacity;
+                x._alloc = _alloc;
+
+                _words = words;
+                _size = size;
+                _capacity = capacity;
+                _alloc = alloc;
+            }
+
+            static void swap(reference x, reference y) {
+                bool tmp = x;
+                x = y;
+                y = tmp;
+            }
+
+            // inverts every element, a word at a time
+            void flip() {
+                size_t words = detail::bit_words(_size);
+                for (size_t i = 0; i < words; i++)
+                    _words[i] = ~_words[i];
+                if (_size % detail::bit_word_bits)
+                    _words[words - 1] &= detail::bit_mask_below(_size % detail::bit_word_bits);
+            }
+
+            void clear() {
+                _truncate(0);
+            }
+
+            allocator_type get_allocator() const {
+                return allocator_type(_alloc);
+            }
+    };
+
+    // count and find over bits go a word at a time
+    inline BitIterator::difference_type count(BitIterator first, BitIterator last, bool val) {
+        size_t begin = detail::bit_access::bit(first);
+        size_t end = begin + (last - first);
+        size_t ones = detail::count_bits(detail::bit_access::word(first), begin, end);
+        return val ? ones : end - begin - ones;
+    }
+
+    inline BitIterator find(BitIterator first, BitIterator last, bool val) {
+        size_t begin = detail::bit_access::bit(first);
+        size_t end = begin + (last - first);
+        return first + (detail::find_bit(detail::bit_access::word(first), begin, end, val) - begin);
+    }
+
+    // relational operators, whole words at once thanks to the zeroed tail
+    template <class Alloc, class Growth>
+    bool operator==(const vector<bool,Alloc,Growth>& lhs, const vector<bool,Alloc,Growth>& rhs) {
+        size_t words = detail::bit_words(lhs.size());
+        return lhs.size() == rhs.size()
+            && (words == 0 || detail::equal_elements(detail::bit_access::word(lhs.begin()),
+                                                     detail::bit_access::word(rhs.begin()), words));
+    }
+
+    // the first differing bit decides, the vector holding 0 there is less
+    template <class Alloc, class Growth>
+    bool operator<(const vector<bool,Alloc,Growth>& lhs, const vector<bool,Alloc,Growth>& rhs) {
+        size_t                  n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+        size_t                  full = n / detail::bit_word_bits;
+        detail::bit_word const *a = detail::bit_access::word(lhs.begin());
+        detail::bit_word const *b = detail::bit_access::word(rhs.begin());
+        size_t                  i = full ? detail::mismatch_elements(a, b, full) : 0;
+        detail::bit_word        differ = 0;
+        if (i < full)
+            differ = a[i] ^ b[i];
+        else if (n % detail::bit_word_bits)
+            differ = (a[i] ^ b[i]) & detail::bit_mask_below(n % detail::bit_word_bits);
+        if (differ)
+            return (b[i] >> __builtin_ctzll(differ)) & 1;
+        return lhs.size() < rhs.size();
+    }
+} // namespace ft
+
+#endif